@@ -0,0 +1,197 @@
+#include "atlas.h"
+#include <limits.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define WHITE_IMAGE_SIZE 3 // Only the center texel is used, so filtering never reaches the padding
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// A padded rectangle to place, index is the sprite it belongs to or the builder's count for the white image
+typedef struct PackedRect {
+    int index;
+    int x;
+    int y;
+    int width;
+    int height;
+} PackedRect;
+
+// A horizontal segment of the top of everything placed so far, segments are sorted by x and cover the atlas width
+typedef struct SkylineNode {
+    int x;
+    int y;
+    int width;
+} SkylineNode;
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions (local)
+//------------------------------------------------------------------------------------
+
+// Tallest first, then widest first
+static int compare_rects(const void *a, const void *b)
+{
+    const PackedRect *ra = a;
+    const PackedRect *rb = b;
+    if (ra->height != rb->height) {
+        return rb->height - ra->height;
+    }
+    return rb->width - ra->width;
+}
+
+// Lowest y a rectangle can rest at with its left edge on node i, -1 if it would stick out of the atlas
+static int fit_skyline(const SkylineNode *nodes, int i, int width, int atlas_width)
+{
+    if (nodes[i].x + width > atlas_width) {
+        return -1;
+    }
+    int y = 0;
+    for (int left = width; left > 0; left -= nodes[i++].width) {
+        if (nodes[i].y > y) {
+            y = nodes[i].y;
+        }
+    }
+    return y;
+}
+
+// Raise the skyline over a rectangle placed at node i, returns the new node count
+static int add_skyline_level(SkylineNode *nodes, int count, int i, const PackedRect *rect)
+{
+    for (int j = count; j > i; j--) {
+        nodes[j] = nodes[j - 1];
+    }
+    nodes[i] = (SkylineNode) { rect->x, rect->y + rect->height, rect->width };
+    count++;
+
+    // Cut the nodes now hidden under the new one
+    int right = nodes[i].x + nodes[i].width;
+    while (i + 1 < count && nodes[i + 1].x < right) {
+        int shrink = right - nodes[i + 1].x;
+        if (shrink < nodes[i + 1].width) {
+            nodes[i + 1].x += shrink;
+            nodes[i + 1].width -= shrink;
+            break;
+        }
+        for (int j = i + 1; j < count - 1; j++) {
+            nodes[j] = nodes[j + 1];
+        }
+        count--;
+    }
+
+    // Merge neighbours at the same height
+    for (int j = 0; j < count - 1;) {
+        if (nodes[j].y == nodes[j + 1].y) {
+            nodes[j].width += nodes[j + 1].width;
+            for (int k = j + 1; k < count - 1; k++) {
+                nodes[k] = nodes[k + 1];
+            }
+            count--;
+        } else {
+            j++;
+        }
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+int AddAtlasImage(AtlasBuilder *builder, Image image)
+{
+    if (builder->count >= MAX_ATLAS_SPRITES) {
+        TraceLog(LOG_WARNING, "ATLAS: Builder is full, sprite dropped");
+        UnloadImage(image);
+        return -1;
+    }
+    builder->images[builder->count] = image;
+    return builder->count++;
+}
+
+Atlas BuildAtlas(AtlasBuilder *builder, int width)
+{
+    Atlas atlas = { 0 };
+    int count = builder->count;
+
+    PackedRect rects[MAX_ATLAS_SPRITES + 1] = { 0 };
+    for (int i = 0; i < count; i++) {
+        rects[i] = (PackedRect) { i, -1, -1, builder->images[i].width + 2 * ATLAS_PADDING, builder->images[i].height + 2 * ATLAS_PADDING };
+    }
+    rects[count] = (PackedRect) { count, -1, -1, WHITE_IMAGE_SIZE + 2 * ATLAS_PADDING, WHITE_IMAGE_SIZE + 2 * ATLAS_PADDING };
+    qsort(rects, count + 1, sizeof(PackedRect), compare_rects);
+
+    // Skyline bottom-left: every rectangle goes where its top ends up the lowest
+    SkylineNode nodes[MAX_ATLAS_SPRITES + 2] = { { 0, 0, width } };
+    int node_count = 1;
+    int height = 0;
+    for (int r = 0; r < count + 1; r++) {
+        int best = -1;
+        int best_top = INT_MAX;
+        for (int i = 0; i < node_count; i++) {
+            int y = fit_skyline(nodes, i, rects[r].width, width);
+            if (y >= 0 && y + rects[r].height < best_top) {
+                best = i;
+                best_top = y + rects[r].height;
+            }
+        }
+        if (best < 0) {
+            TraceLog(LOG_WARNING, "ATLAS: Sprite %i is wider than the atlas", rects[r].index);
+            continue;
+        }
+        rects[r].x = nodes[best].x;
+        rects[r].y = best_top - rects[r].height;
+        node_count = add_skyline_level(nodes, node_count, best, &rects[r]);
+        if (best_top > height) {
+            height = best_top;
+        }
+    }
+
+    Image image = GenImageColor(width, height, BLANK);
+    for (int r = 0; r < count + 1; r++) {
+        if (rects[r].x < 0) {
+            continue;
+        }
+        Rectangle dest = {
+            rects[r].x + ATLAS_PADDING,
+            rects[r].y + ATLAS_PADDING,
+            rects[r].width - 2 * ATLAS_PADDING,
+            rects[r].height - 2 * ATLAS_PADDING,
+        };
+        if (rects[r].index == count) {
+            ImageDrawRectangleRec(&image, dest, WHITE);
+            atlas.white = (Rectangle) { dest.x + 1, dest.y + 1, 1, 1 };
+        } else {
+            Image sprite = builder->images[rects[r].index];
+            ImageDraw(&image, sprite, (Rectangle) { 0, 0, sprite.width, sprite.height }, dest, WHITE);
+            atlas.sprites[rects[r].index] = dest;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        UnloadImage(builder->images[i]);
+    }
+    builder->count = 0;
+
+    atlas.texture = LoadTextureFromImage(image);
+    atlas.spriteCount = count;
+    UnloadImage(image);
+    TraceLog(LOG_INFO, "ATLAS: Packed %i sprites into %ix%i", count, width, height);
+
+    return atlas;
+}
+
+void UnloadAtlas(Atlas atlas)
+{
+    UnloadTexture(atlas.texture);
+}
+
+void DrawAtlasSprite(Atlas atlas, int sprite, Rectangle dest, Color tint)
+{
+    if (sprite < 0 || sprite >= atlas.spriteCount) {
+        return;
+    }
+    DrawTexturePro(atlas.texture, atlas.sprites[sprite], dest, (Vector2) { 0 }, 0.0f, tint);
+}
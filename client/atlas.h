@@ -0,0 +1,38 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MAX_ATLAS_SPRITES 64
+#define ATLAS_PADDING 1 // Transparent pixels around every sprite, so neighbours never bleed in
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Images waiting to be packed, sprites are numbered in the order they were added
+typedef struct AtlasBuilder {
+    Image images[MAX_ATLAS_SPRITES];
+    int count;
+} AtlasBuilder;
+
+// Every sprite packed into a single texture, drawing any of them never switches textures
+typedef struct Atlas {
+    Texture2D texture;
+    Rectangle sprites[MAX_ATLAS_SPRITES]; // Source rectangle of each sprite in the texture
+    int spriteCount;
+    Rectangle white; // A single white texel, for SetShapesTexture()
+} Atlas;
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+int AddAtlasImage(AtlasBuilder *builder, Image image); // Add an image, the builder owns it from now on. Returns its sprite index, -1 when full
+Atlas BuildAtlas(AtlasBuilder *builder, int width); // Pack every image into a texture of the given width and unload the images
+void UnloadAtlas(Atlas atlas); // Unload the atlas texture
+void DrawAtlasSprite(Atlas atlas, int sprite, Rectangle dest, Color tint); // Draw a sprite stretched over dest
+
+#endif // ATLAS_H
@@ -0,0 +1,83 @@
+#include "raylib.h"
+#include "rlgl.h"
+#include <stdio.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define SCREEN_WIDTH 800
+#define SCREEN_HEIGHT 450
+#define RECTS_PER_FRAME 16384
+#define RECTS_PER_BATCH (RL_DEFAULT_BATCH_BUFFER_ELEMENTS / 2) // Drawn explicitly before the batch fills up, so filling and drawing are timed apart
+#define FRAMES_PER_RUN 60
+#define RECT_SIZE 12
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum {
+    RUN_PRO = 0, // DrawRectanglePro() with rotation 0, the old DrawRectangleV() path
+    RUN_AXIS_ALIGNED, // DrawRectangleV(), the axis-aligned fast path
+    RUN_COUNT
+} Run;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static const char *run_names[RUN_COUNT] = { "DrawRectanglePro", "DrawRectangleV" };
+static const char *version_names[] = { "", "OpenGL 1.1", "OpenGL 2.1", "OpenGL 3.3", "OpenGL 4.3", "OpenGL ES 2.0", "OpenGL ES 3.0" };
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+// Measures the CPU time to fill the rlgl batch with rectangles and to draw it, swap and vsync excluded
+// NOTE: OpenGL 1.1 has no batch, both paths send vertices straight to the driver and filling includes its work
+int main(void)
+{
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "bench: rectangles");
+
+    double fill_time[RUN_COUNT] = { 0 };
+    double draw_time[RUN_COUNT] = { 0 };
+
+    for (int run = 0; run < RUN_COUNT && !WindowShouldClose(); run++) {
+        for (int frame = 0; frame < FRAMES_PER_RUN && !WindowShouldClose(); frame++) {
+            BeginDrawing();
+            ClearBackground(RAYWHITE);
+            rlDrawRenderBatchActive();
+
+            for (int first = 0; first < RECTS_PER_FRAME; first += RECTS_PER_BATCH) {
+                double start = GetTime();
+                for (int i = first; i < first + RECTS_PER_BATCH && i < RECTS_PER_FRAME; i++) {
+                    Vector2 position = { (float)((i * 37) % (SCREEN_WIDTH - RECT_SIZE)), (float)((i * 91) % (SCREEN_HEIGHT - RECT_SIZE)) };
+                    Color color = { (unsigned char)i, (unsigned char)(i >> 8), 128, 255 };
+                    if (run == RUN_PRO) {
+                        DrawRectanglePro((Rectangle) { position.x, position.y, RECT_SIZE, RECT_SIZE }, (Vector2) { 0.0f, 0.0f }, 0.0f, color);
+                    } else {
+                        DrawRectangleV(position, (Vector2) { RECT_SIZE, RECT_SIZE }, color);
+                    }
+                }
+                double filled = GetTime();
+                rlDrawRenderBatchActive();
+                fill_time[run] += filled - start;
+                draw_time[run] += GetTime() - filled;
+            }
+
+            DrawText(run_names[run], 10, 10, 20, BLACK);
+            EndDrawing();
+        }
+    }
+
+    CloseWindow();
+
+    double rects = (double)RECTS_PER_FRAME * FRAMES_PER_RUN;
+    printf("%s, %d rects per frame\n", version_names[rlGetVersion()], RECTS_PER_FRAME);
+    printf("%-18s %14s %14s\n", "", "fill rects/s", "total rects/s");
+    for (int run = 0; run < RUN_COUNT; run++) {
+        printf("%-18s %14.0f %14.0f\n", run_names[run], rects / fill_time[run], rects / (fill_time[run] + draw_time[run]));
+    }
+    if (fill_time[RUN_AXIS_ALIGNED] > 0.0) {
+        printf("%-18s %13.2fx %13.2fx\n", "speedup", fill_time[RUN_PRO] / fill_time[RUN_AXIS_ALIGNED], (fill_time[RUN_PRO] + draw_time[RUN_PRO]) / (fill_time[RUN_AXIS_ALIGNED] + draw_time[RUN_AXIS_ALIGNED]));
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "damagenumbers.h"
+#include "rlgl.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MAX_DIGITS 10 // Enough for any int
+#define FADE_TICKS (DAMAGE_NUMBER_LIFE / 3) // Numbers fade out over the end of their life
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+
+// Every number lives exactly DAMAGE_NUMBER_LIFE ticks, so they expire in the order they were spawned and a ring is enough
+static DamageNumber numbers[MAX_DAMAGE_NUMBERS] = { 0 };
+static int firstNumber = 0;
+static int numberCount = 0;
+
+static Texture2D digitTexture = { 0 };
+static Rectangle digitStrip = { 0 };
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+void SetDamageNumberDigits(Texture2D texture, Rectangle strip)
+{
+    digitTexture = texture;
+    digitStrip = strip;
+}
+
+void ResetDamageNumbers(void)
+{
+    firstNumber = 0;
+    numberCount = 0;
+}
+
+void SpawnDamageNumber(int value, Vector2 position)
+{
+    if (value <= 0) {
+        return;
+    }
+    if (numberCount == MAX_DAMAGE_NUMBERS) {
+        firstNumber = (firstNumber + 1) % MAX_DAMAGE_NUMBERS;
+        numberCount--;
+    }
+    numbers[(firstNumber + numberCount++) % MAX_DAMAGE_NUMBERS] = (DamageNumber) { value, position, 0 };
+}
+
+void UpdateDamageNumbers(void)
+{
+    for (int k = 0; k < numberCount; k++) {
+        numbers[(firstNumber + k) % MAX_DAMAGE_NUMBERS].age++;
+    }
+    while (numberCount > 0 && numbers[firstNumber].age >= DAMAGE_NUMBER_LIFE) {
+        firstNumber = (firstNumber + 1) % MAX_DAMAGE_NUMBERS;
+        numberCount--;
+    }
+}
+
+void DrawDamageNumbers(Rectangle bounds, Color color)
+{
+    if (numberCount == 0 || digitTexture.id == 0) {
+        return;
+    }
+
+    float width = digitStrip.width / 10;
+    float height = digitStrip.height;
+    float s = width / digitTexture.width;
+    float t0 = digitStrip.y / digitTexture.height;
+    float t1 = (digitStrip.y + digitStrip.height) / digitTexture.height;
+
+    rlSetTexture(digitTexture.id);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    for (int k = 0; k < numberCount; k++) {
+        const DamageNumber *number = &numbers[(firstNumber + k) % MAX_DAMAGE_NUMBERS];
+        Vector2 position = { number->position.x, number->position.y - number->age * DAMAGE_NUMBER_RISE };
+        if (position.x < bounds.x || position.y < bounds.y || position.x >= bounds.x + bounds.width || position.y >= bounds.y + bounds.height) {
+            continue;
+        }
+
+        // Split the value into digits, least significant first
+        int digits[MAX_DIGITS];
+        int digit_count = 0;
+        for (int value = number->value; value > 0 && digit_count < MAX_DIGITS; value /= 10) {
+            digits[digit_count++] = value % 10;
+        }
+
+        int ticks_left = DAMAGE_NUMBER_LIFE - number->age;
+        unsigned char alpha = ticks_left < FADE_TICKS ? color.a * ticks_left / FADE_TICKS : color.a;
+        rlColor4ub(color.r, color.g, color.b, alpha);
+
+        float x = position.x - digit_count * width / 2;
+        float y = position.y - height;
+        for (int d = digit_count - 1; d >= 0; d--) {
+            float s0 = (digitStrip.x + digits[d] * width) / digitTexture.width;
+            rlRectangle2f(x, y, width, height, s0, t0, s0 + s, t1);
+            x += width;
+        }
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+}
+
+int GetDamageNumberCount(void)
+{
+    return numberCount;
+}
@@ -0,0 +1,34 @@
+#ifndef DAMAGENUMBERS_H
+#define DAMAGENUMBERS_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MAX_DAMAGE_NUMBERS 2048 // The oldest number is replaced when a new one doesn't fit
+#define DAMAGE_NUMBER_LIFE 45 // In ticks
+#define DAMAGE_NUMBER_RISE 0.5f // Pixels per tick
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// A number floating up from where damage was dealt, only the value is kept, it's never turned into a string
+typedef struct DamageNumber {
+    int value;
+    Vector2 position; // Where it was spawned, the bottom center of the digits
+    int age; // In ticks
+} DamageNumber;
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+void SetDamageNumberDigits(Texture2D texture, Rectangle strip); // Set the digit strip: 0 to 9 in ten equal-width cells of a texture
+void ResetDamageNumbers(void); // Remove every number
+void SpawnDamageNumber(int value, Vector2 position); // Start a number floating up from position
+void UpdateDamageNumbers(void); // Age every number by one tick
+void DrawDamageNumbers(Rectangle bounds, Color color); // Draw the numbers inside bounds, all in the same batch
+int GetDamageNumberCount(void); // Get the number of damage numbers still floating
+
+#endif // DAMAGENUMBERS_H
@@ -97,6 +97,12 @@ elseif ("${PLATFORM}" MATCHES "SDL")
     set(PLATFORM_CPP "PLATFORM_DESKTOP_SDL")
     set(LIBS_PRIVATE SDL2::SDL2)
 
+elseif ("${PLATFORM}" MATCHES "Memory")
+    # Headless, rendered on CPU by rlsw: no OpenGL, no windowing library
+    set(PLATFORM_CPP "PLATFORM_MEMORY")
+    set(GRAPHICS "GRAPHICS_API_OPENGL_11_SOFTWARE")
+    set(LIBS_PRIVATE m pthread dl)
+
 endif ()
 
 if (NOT ${OPENGL_VERSION} MATCHES "OFF")
@@ -58,10 +58,16 @@
 //#define SUPPORT_BUSY_WAIT_LOOP          1
 // Use a partial-busy wait loop, in this case frame sleeps for most of the time, but then runs a busy loop at the end for accuracy
 #define SUPPORT_PARTIALBUSY_WAIT_LOOP    1
+// Pace frames on Linux with clock_nanosleep() on absolute deadlines, only spinning for the measured oversleep
+// NOTE: Replaces the partial-busy wait loop there, most of the frame wait is spent sleeping
+#define SUPPORT_PRECISE_FRAME_PACING    1
 // Allow automatic screen capture of current screen pressing F12, defined in KeyCallback()
 #define SUPPORT_SCREEN_CAPTURE          1
 // Allow automatic gif recording of current screen pressing CTRL+F12, defined in KeyCallback()
 #define SUPPORT_GIF_RECORDING           1
+// Read screen captures back a few frames later through pixel buffers and encode them on a worker thread
+// NOTE: Used by TakeScreenshotAsync() and the F12 screenshot, requires pthreads to encode off the main thread
+#define SUPPORT_ASYNC_SCREEN_CAPTURE    1
 // Support CompressData() and DecompressData() functions
 #define SUPPORT_COMPRESSION_API         1
 // Support automatic generated events, loading and recording of those events when required
@@ -101,7 +107,7 @@
 //#define RLGL_SHOW_GL_DETAILS_INFO              1
 
 //#define RL_DEFAULT_BATCH_BUFFER_ELEMENTS    4096    // Default internal render batch elements limits
-#define RL_DEFAULT_BATCH_BUFFERS               1      // Default number of batch buffers (multi-buffering)
+#define RL_DEFAULT_BATCH_BUFFERS               3      // Default number of batch buffers (multi-buffering)
 #define RL_DEFAULT_BATCH_DRAWCALLS           256      // Default number of batch draw calls (by state changes: mode, texture)
 #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS     4      // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 
@@ -206,6 +212,7 @@
 #define MAX_TEXT_BUFFER_LENGTH       1024       // Size of internal static buffers used on some functions:
                                                 // TextFormat(), TextSubtext(), TextToUpper(), TextToLower(), TextToPascal(), TextSplit()
 #define MAX_TEXTSPLIT_COUNT           128       // Maximum number of substrings to split: TextSplit()
+#define MAX_GLYPH_LOOKUP_FONTS          8       // Maximum number of loaded fonts with a codepoint lookup table: GetGlyphIndex()
 
 
 //------------------------------------------------------------------------------------
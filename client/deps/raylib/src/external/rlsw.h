@@ -0,0 +1,1549 @@
+/**********************************************************************************************
+*
+*   rlsw v1.0 - Software rasterizer implementing the subset of OpenGL 1.1 used by rlgl
+*
+*   FEATURES:
+*       - Immediate mode (glBegin/glEnd) and client vertex arrays (glDrawArrays/glDrawElements)
+*       - Lines, triangles and quads, smooth or flat shaded, filled or wireframe
+*       - 2D textures (stored as RGBA8), nearest/linear filtering, repeat/clamp/mirror wrapping
+*       - Texture modulation by vertex color, alpha blending with any glBlendFunc() factors
+*       - Projection, modelview and texture matrix stacks, viewport, scissor, backface culling
+*       - Renders into an in-memory RGBA8 color buffer, readable with glReadPixels()
+*
+*   LIMITATIONS:
+*       - Lines are not antialiased, GL_LINE_SMOOTH is accepted but ignored
+*       - No depth buffer: GL_DEPTH_TEST is accepted but ignored (rlgl only needs it for 3D)
+*       - No near/far clipping, primitives with a vertex behind the eye (w <= 0) are dropped
+*       - Mipmap levels above 0 are ignored, texture matrix is kept but not applied
+*       - No lighting, fog, stencil, accumulation or display lists
+*
+*   ADDITIONAL NOTES:
+*       Function names mirror the OpenGL ones with a 'sw' prefix, GL_* enums and types are
+*       defined here, so rlgl can map its OpenGL 1.1 code path onto rlsw with plain defines.
+*       Do not include this header together with <GL/gl.h>.
+*
+*       Window coordinates follow OpenGL: (0, 0) is the bottom-left corner of the color buffer.
+*       Triangles are rasterized with fixed-point edge functions (SW_SUBPIXEL_BITS) and a
+*       consistent tie-breaking rule, so triangles sharing an edge never touch a pixel twice.
+*
+*   CONFIGURATION:
+*       #define RLSW_IMPLEMENTATION
+*           Generates the implementation of the library into the included file.
+*           If not defined, the library is in header only mode and can be included in other headers
+*           or source files without problems. But only ONE file should hold the implementation.
+*
+*       #define SW_MAX_TEXTURES
+*       #define SW_MAX_MATRIX_STACK_SIZE
+*       #define SW_SUBPIXEL_BITS
+*           Override the default limits, see below
+*
+*   DEPENDENCIES: libc (stdlib, string, math)
+*
+*   VERSIONS HISTORY:
+*       1.0 (2024) First version
+*
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2024 raylib contributors
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+#ifndef RLSW_H
+#define RLSW_H
+
+#ifndef RLSWAPI
+    #define RLSWAPI
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#ifndef SW_MAX_TEXTURES
+    #define SW_MAX_TEXTURES                 1024    // Maximum textures alive at the same time
+#endif
+#ifndef SW_MAX_MATRIX_STACK_SIZE
+    #define SW_MAX_MATRIX_STACK_SIZE          32    // Depth of each matrix stack
+#endif
+#ifndef SW_SUBPIXEL_BITS
+    #define SW_SUBPIXEL_BITS                   4    // Fixed-point precision of window coordinates (1/16 pixel)
+#endif
+
+// OpenGL 1.1 types
+typedef unsigned int GLenum;
+typedef unsigned char GLboolean;
+typedef unsigned int GLbitfield;
+typedef void GLvoid;
+typedef signed char GLbyte;
+typedef short GLshort;
+typedef int GLint;
+typedef unsigned char GLubyte;
+typedef unsigned short GLushort;
+typedef unsigned int GLuint;
+typedef int GLsizei;
+typedef float GLfloat;
+typedef float GLclampf;
+typedef double GLdouble;
+typedef double GLclampd;
+
+// OpenGL 1.1 enums (only the ones implemented)
+#define GL_FALSE                            0
+#define GL_TRUE                             1
+
+#define GL_LINES                            0x0001
+#define GL_TRIANGLES                        0x0004
+#define GL_QUADS                            0x0007
+
+#define GL_MODELVIEW                        0x1700
+#define GL_PROJECTION                       0x1701
+#define GL_TEXTURE                          0x1702
+#define GL_MODELVIEW_MATRIX                 0x0BA6
+#define GL_PROJECTION_MATRIX                0x0BA7
+#define GL_TEXTURE_MATRIX                   0x0BA8
+#define GL_LINE_WIDTH                       0x0B21
+#define GL_COLOR_CLEAR_VALUE                0x0C22
+
+#define GL_VENDOR                           0x1F00
+#define GL_RENDERER                         0x1F01
+#define GL_VERSION                          0x1F02
+#define GL_EXTENSIONS                       0x1F03
+
+#define GL_TEXTURE_2D                       0x0DE1
+#define GL_LINE_SMOOTH                      0x0B20
+#define GL_BLEND                            0x0BE2
+#define GL_CULL_FACE                        0x0B44
+#define GL_DEPTH_TEST                       0x0B71
+#define GL_SCISSOR_TEST                     0x0C11
+
+#define GL_COLOR_BUFFER_BIT                 0x00004000
+#define GL_DEPTH_BUFFER_BIT                 0x00000100
+#define GL_STENCIL_BUFFER_BIT               0x00000400
+
+#define GL_ZERO                             0
+#define GL_ONE                              1
+#define GL_SRC_COLOR                        0x0300
+#define GL_ONE_MINUS_SRC_COLOR              0x0301
+#define GL_SRC_ALPHA                        0x0302
+#define GL_ONE_MINUS_SRC_ALPHA              0x0303
+#define GL_DST_ALPHA                        0x0304
+#define GL_ONE_MINUS_DST_ALPHA              0x0305
+#define GL_DST_COLOR                        0x0306
+#define GL_ONE_MINUS_DST_COLOR              0x0307
+#define GL_SRC_ALPHA_SATURATE               0x0308
+
+#define GL_NEVER                            0x0200
+#define GL_LESS                             0x0201
+#define GL_EQUAL                            0x0202
+#define GL_LEQUAL                           0x0203
+#define GL_GREATER                          0x0204
+#define GL_NOTEQUAL                         0x0205
+#define GL_GEQUAL                           0x0206
+#define GL_ALWAYS                           0x0207
+
+#define GL_FRONT                            0x0404
+#define GL_BACK                             0x0405
+#define GL_FRONT_AND_BACK                   0x0408
+#define GL_CW                               0x0900
+#define GL_CCW                              0x0901
+
+#define GL_POINT                            0x1B00
+#define GL_LINE                             0x1B01
+#define GL_FILL                             0x1B02
+#define GL_FLAT                             0x1D00
+#define GL_SMOOTH                           0x1D01
+
+#define GL_DONT_CARE                        0x1100
+#define GL_FASTEST                          0x1101
+#define GL_NICEST                           0x1102
+#define GL_PERSPECTIVE_CORRECTION_HINT      0x0C50
+
+#define GL_UNPACK_ALIGNMENT                 0x0CF5
+#define GL_PACK_ALIGNMENT                   0x0D05
+
+#define GL_BYTE                             0x1400
+#define GL_UNSIGNED_BYTE                    0x1401
+#define GL_SHORT                            0x1402
+#define GL_UNSIGNED_SHORT                   0x1403
+#define GL_INT                              0x1404
+#define GL_UNSIGNED_INT                     0x1405
+#define GL_FLOAT                            0x1406
+#define GL_UNSIGNED_SHORT_4_4_4_4           0x8033
+#define GL_UNSIGNED_SHORT_5_5_5_1           0x8034
+#define GL_UNSIGNED_SHORT_5_6_5             0x8363
+
+#define GL_ALPHA                            0x1906
+#define GL_RGB                              0x1907
+#define GL_RGBA                             0x1908
+#define GL_LUMINANCE                        0x1909
+#define GL_LUMINANCE_ALPHA                  0x190A
+
+#define GL_TEXTURE_MAG_FILTER               0x2800
+#define GL_TEXTURE_MIN_FILTER               0x2801
+#define GL_TEXTURE_WRAP_S                   0x2802
+#define GL_TEXTURE_WRAP_T                   0x2803
+#define GL_NEAREST                          0x2600
+#define GL_LINEAR                           0x2601
+#define GL_NEAREST_MIPMAP_NEAREST           0x2700
+#define GL_LINEAR_MIPMAP_NEAREST            0x2701
+#define GL_NEAREST_MIPMAP_LINEAR            0x2702
+#define GL_LINEAR_MIPMAP_LINEAR             0x2703
+#define GL_CLAMP                            0x2900
+#define GL_REPEAT                           0x2901
+#define GL_CLAMP_TO_EDGE                    0x812F
+#define GL_MIRRORED_REPEAT                  0x8370
+
+#define GL_VERTEX_ARRAY                     0x8074
+#define GL_NORMAL_ARRAY                     0x8075
+#define GL_COLOR_ARRAY                      0x8076
+#define GL_TEXTURE_COORD_ARRAY              0x8078
+
+#if defined(__cplusplus)
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//------------------------------------------------------------------------------------
+// Functions Declaration - Context
+//------------------------------------------------------------------------------------
+RLSWAPI bool swInit(int width, int height);                      // Initialize context and allocate the color buffer
+RLSWAPI void swClose(void);                                      // Free the color buffer and every texture
+RLSWAPI bool swResize(int width, int height);                    // Reallocate the color buffer, contents are lost
+RLSWAPI unsigned char *swGetColorBuffer(int *width, int *height); // Get the color buffer: RGBA8, rows bottom-up
+
+//------------------------------------------------------------------------------------
+// Functions Declaration - OpenGL 1.1 subset
+//------------------------------------------------------------------------------------
+RLSWAPI void swEnable(GLenum cap);
+RLSWAPI void swDisable(GLenum cap);
+RLSWAPI void swHint(GLenum target, GLenum mode);
+RLSWAPI void swShadeModel(GLenum mode);
+RLSWAPI void swPixelStorei(GLenum pname, GLint param);
+RLSWAPI void swPolygonMode(GLenum face, GLenum mode);
+RLSWAPI void swLineWidth(GLfloat width);
+RLSWAPI void swCullFace(GLenum mode);
+RLSWAPI void swFrontFace(GLenum mode);
+RLSWAPI void swDepthFunc(GLenum func);
+RLSWAPI void swDepthMask(GLboolean flag);
+RLSWAPI void swColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+RLSWAPI void swBlendFunc(GLenum sfactor, GLenum dfactor);
+RLSWAPI void swScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+RLSWAPI void swViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+RLSWAPI void swClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+RLSWAPI void swClearDepth(GLclampd depth);
+RLSWAPI void swClear(GLbitfield mask);
+RLSWAPI void swGetFloatv(GLenum pname, GLfloat *params);
+RLSWAPI const GLubyte *swGetString(GLenum name);
+
+RLSWAPI void swMatrixMode(GLenum mode);
+RLSWAPI void swPushMatrix(void);
+RLSWAPI void swPopMatrix(void);
+RLSWAPI void swLoadIdentity(void);
+RLSWAPI void swMultMatrixf(const GLfloat *m);
+RLSWAPI void swTranslatef(GLfloat x, GLfloat y, GLfloat z);
+RLSWAPI void swRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z);
+RLSWAPI void swScalef(GLfloat x, GLfloat y, GLfloat z);
+RLSWAPI void swOrtho(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble znear, GLdouble zfar);
+RLSWAPI void swFrustum(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble znear, GLdouble zfar);
+
+RLSWAPI void swBegin(GLenum mode);
+RLSWAPI void swEnd(void);
+RLSWAPI void swVertex2i(GLint x, GLint y);
+RLSWAPI void swVertex2f(GLfloat x, GLfloat y);
+RLSWAPI void swVertex3f(GLfloat x, GLfloat y, GLfloat z);
+RLSWAPI void swTexCoord2f(GLfloat s, GLfloat t);
+RLSWAPI void swNormal3f(GLfloat nx, GLfloat ny, GLfloat nz);
+RLSWAPI void swColor4ub(GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha);
+RLSWAPI void swColor3f(GLfloat red, GLfloat green, GLfloat blue);
+RLSWAPI void swColor4f(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+
+RLSWAPI void swEnableClientState(GLenum array);
+RLSWAPI void swDisableClientState(GLenum array);
+RLSWAPI void swVertexPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+RLSWAPI void swTexCoordPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+RLSWAPI void swColorPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+RLSWAPI void swNormalPointer(GLenum type, GLsizei stride, const GLvoid *pointer);
+RLSWAPI void swDrawArrays(GLenum mode, GLint first, GLsizei count);
+RLSWAPI void swDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices);
+
+RLSWAPI void swGenTextures(GLsizei n, GLuint *textures);
+RLSWAPI void swDeleteTextures(GLsizei n, const GLuint *textures);
+RLSWAPI void swBindTexture(GLenum target, GLuint texture);
+RLSWAPI void swTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels);
+RLSWAPI void swTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels);
+RLSWAPI void swTexParameteri(GLenum target, GLenum pname, GLint param);
+RLSWAPI void swGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, GLvoid *pixels);
+RLSWAPI void swReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // RLSW_H
+
+/***********************************************************************************
+*
+*   RLSW IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(RLSW_IMPLEMENTATION)
+
+#include <stdlib.h>                 // Required for: malloc(), calloc(), free()
+#include <string.h>                 // Required for: memset(), memcpy()
+#include <math.h>                   // Required for: sinf(), cosf(), sqrtf(), floorf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SW_SUBPIXEL_ONE         (1 << SW_SUBPIXEL_BITS)
+#define SW_MAX_COORD            (1 << 24)           // Fixed-point coordinates beyond this are dropped to avoid overflows
+
+#define SW_ARRAY_VERTEX         0
+#define SW_ARRAY_TEXCOORD       1
+#define SW_ARRAY_COLOR          2
+#define SW_ARRAY_NORMAL         3
+#define SW_ARRAY_COUNT          4
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Texture, always stored as RGBA8, row 0 is at t = 0
+typedef struct swTexture {
+    unsigned char *pixels;
+    int width;
+    int height;
+    int minFilter;
+    int magFilter;
+    int wrapS;
+    int wrapT;
+    bool used;
+} swTexture;
+
+// Vertex after transformation: window coordinates, 1/w and attributes
+typedef struct swVertex {
+    float x, y;                     // Window coordinates
+    float invW;                     // Used for perspective-correct interpolation
+    float texcoord[2];
+    float color[4];                 // Normalized
+    bool valid;                     // False when the vertex is behind the eye
+} swVertex;
+
+// Client vertex array
+typedef struct swArray {
+    bool enabled;
+    int size;
+    int type;
+    int stride;
+    const unsigned char *pointer;
+} swArray;
+
+typedef struct swContext {
+    unsigned char *colorBuffer;     // RGBA8, rows bottom-up
+    int width;
+    int height;
+
+    int viewport[4];
+    int scissor[4];
+    float clearColor[4];
+    bool colorMask[4];
+
+    float stack[3][SW_MAX_MATRIX_STACK_SIZE][16];   // Projection, modelview and texture stacks (column-major)
+    int stackDepth[3];
+    int matrixMode;                 // Index of the current stack
+    float mvp[16];
+    bool mvpDirty;
+
+    int primitiveMode;
+    swVertex primitive[4];          // Vertices of the primitive being assembled
+    int vertexCount;
+    float texcoord[2];              // Current attributes
+    float color[4];
+
+    bool texture2D;
+    bool blend;
+    bool cullFace;
+    bool scissorTest;
+    bool depthTest;                 // Tracked only, there is no depth buffer
+    int srcFactor;
+    int dstFactor;
+    int cullMode;
+    int frontFace;
+    int shadeModel;
+    int polygonMode;
+    float lineWidth;
+    int unpackAlignment;
+    int packAlignment;
+
+    swTexture textures[SW_MAX_TEXTURES];    // Texture id is the index + 1
+    unsigned int boundTexture;
+
+    swArray arrays[SW_ARRAY_COUNT];
+} swContext;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static swContext SW = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Declaration
+//----------------------------------------------------------------------------------
+static void swMatrixMultiply(float *result, const float *left, const float *right);
+static void swMultCurrent(const float *m);
+static swTexture *swGetTexture(unsigned int id);
+static void swUnpackPixel(const unsigned char *src, int format, int type, unsigned char *rgba);
+static void swPackPixel(const unsigned char *rgba, int format, int type, unsigned char *dst);
+static int swGetPixelSize(int format, int type);
+static void swSampleTexture(const swTexture *texture, float s, float t, int filter, float *color);
+static void swWriteFragment(int x, int y, const float *color);
+static void swGetClipRect(int *x0, int *y0, int *x1, int *y1);
+static void swTransformVertex(float x, float y, float z, float w, swVertex *out);
+static void swRasterizeLine(const swVertex *v0, const swVertex *v1);
+static void swRasterizeTriangle(const swVertex *v0, const swVertex *v1, const swVertex *v2, const float *flatColor);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Context
+//----------------------------------------------------------------------------------
+
+// Initialize context and allocate the color buffer
+bool swInit(int width, int height)
+{
+    memset(&SW, 0, sizeof(swContext));
+
+    for (int m = 0; m < 3; m++)
+    {
+        float *top = SW.stack[m][0];
+        memset(top, 0, 16*sizeof(float));
+        top[0] = top[5] = top[10] = top[15] = 1.0f;
+    }
+    SW.matrixMode = 1;
+    SW.mvpDirty = true;
+
+    SW.colorMask[0] = SW.colorMask[1] = SW.colorMask[2] = SW.colorMask[3] = true;
+    SW.color[0] = SW.color[1] = SW.color[2] = SW.color[3] = 1.0f;
+    SW.srcFactor = GL_ONE;
+    SW.dstFactor = GL_ZERO;
+    SW.cullMode = GL_BACK;
+    SW.frontFace = GL_CCW;
+    SW.shadeModel = GL_SMOOTH;
+    SW.polygonMode = GL_FILL;
+    SW.lineWidth = 1.0f;
+    SW.unpackAlignment = 4;
+    SW.packAlignment = 4;
+
+    return swResize(width, height);
+}
+
+// Free the color buffer and every texture
+void swClose(void)
+{
+    for (int i = 0; i < SW_MAX_TEXTURES; i++) free(SW.textures[i].pixels);
+    free(SW.colorBuffer);
+    memset(&SW, 0, sizeof(swContext));
+}
+
+// Reallocate the color buffer, viewport and scissor are reset to cover it
+bool swResize(int width, int height)
+{
+    if ((width <= 0) || (height <= 0)) return false;
+
+    unsigned char *buffer = (unsigned char *)calloc((size_t)width*height, 4);
+    if (buffer == NULL) return false;
+
+    free(SW.colorBuffer);
+    SW.colorBuffer = buffer;
+    SW.width = width;
+    SW.height = height;
+    swViewport(0, 0, width, height);
+    swScissor(0, 0, width, height);
+
+    return true;
+}
+
+// Get the color buffer: RGBA8, rows bottom-up
+unsigned char *swGetColorBuffer(int *width, int *height)
+{
+    if (width != NULL) *width = SW.width;
+    if (height != NULL) *height = SW.height;
+
+    return SW.colorBuffer;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - State
+//----------------------------------------------------------------------------------
+
+void swEnable(GLenum cap)
+{
+    switch (cap)
+    {
+        case GL_TEXTURE_2D: SW.texture2D = true; break;
+        case GL_BLEND: SW.blend = true; break;
+        case GL_CULL_FACE: SW.cullFace = true; break;
+        case GL_SCISSOR_TEST: SW.scissorTest = true; break;
+        case GL_DEPTH_TEST: SW.depthTest = true; break;
+        default: break;
+    }
+}
+
+void swDisable(GLenum cap)
+{
+    switch (cap)
+    {
+        case GL_TEXTURE_2D: SW.texture2D = false; break;
+        case GL_BLEND: SW.blend = false; break;
+        case GL_CULL_FACE: SW.cullFace = false; break;
+        case GL_SCISSOR_TEST: SW.scissorTest = false; break;
+        case GL_DEPTH_TEST: SW.depthTest = false; break;
+        default: break;
+    }
+}
+
+void swHint(GLenum target, GLenum mode) { (void)target; (void)mode; }
+void swShadeModel(GLenum mode) { SW.shadeModel = mode; }
+void swPolygonMode(GLenum face, GLenum mode) { (void)face; SW.polygonMode = mode; }
+void swLineWidth(GLfloat width) { SW.lineWidth = (width > 0.0f)? width : 1.0f; }
+void swCullFace(GLenum mode) { SW.cullMode = mode; }
+void swFrontFace(GLenum mode) { SW.frontFace = mode; }
+void swDepthFunc(GLenum func) { (void)func; }
+void swDepthMask(GLboolean flag) { (void)flag; }
+void swClearDepth(GLclampd depth) { (void)depth; }
+
+void swPixelStorei(GLenum pname, GLint param)
+{
+    if ((param != 1) && (param != 2) && (param != 4) && (param != 8)) return;
+
+    if (pname == GL_UNPACK_ALIGNMENT) SW.unpackAlignment = param;
+    else if (pname == GL_PACK_ALIGNMENT) SW.packAlignment = param;
+}
+
+void swColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+    SW.colorMask[0] = red;
+    SW.colorMask[1] = green;
+    SW.colorMask[2] = blue;
+    SW.colorMask[3] = alpha;
+}
+
+void swBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    SW.srcFactor = sfactor;
+    SW.dstFactor = dfactor;
+}
+
+void swScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    SW.scissor[0] = x;
+    SW.scissor[1] = y;
+    SW.scissor[2] = width;
+    SW.scissor[3] = height;
+}
+
+void swViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    SW.viewport[0] = x;
+    SW.viewport[1] = y;
+    SW.viewport[2] = width;
+    SW.viewport[3] = height;
+}
+
+void swClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+    SW.clearColor[0] = red;
+    SW.clearColor[1] = green;
+    SW.clearColor[2] = blue;
+    SW.clearColor[3] = alpha;
+}
+
+// Clear the color buffer, scissor test and color mask apply like on OpenGL
+void swClear(GLbitfield mask)
+{
+    if (!(mask & GL_COLOR_BUFFER_BIT) || (SW.colorBuffer == NULL)) return;
+
+    unsigned char clear[4] = { 0 };
+    for (int i = 0; i < 4; i++)
+    {
+        float value = (SW.clearColor[i] < 0.0f)? 0.0f : (SW.clearColor[i] > 1.0f)? 1.0f : SW.clearColor[i];
+        clear[i] = (unsigned char)(value*255.0f + 0.5f);
+    }
+
+    int x0 = 0, y0 = 0, x1 = SW.width, y1 = SW.height;
+    if (SW.scissorTest)
+    {
+        if (SW.scissor[0] > x0) x0 = SW.scissor[0];
+        if (SW.scissor[1] > y0) y0 = SW.scissor[1];
+        if (SW.scissor[0] + SW.scissor[2] < x1) x1 = SW.scissor[0] + SW.scissor[2];
+        if (SW.scissor[1] + SW.scissor[3] < y1) y1 = SW.scissor[1] + SW.scissor[3];
+    }
+
+    bool fullMask = SW.colorMask[0] && SW.colorMask[1] && SW.colorMask[2] && SW.colorMask[3];
+
+    for (int y = y0; y < y1; y++)
+    {
+        unsigned char *row = SW.colorBuffer + ((size_t)y*SW.width + x0)*4;
+        for (int x = x0; x < x1; x++, row += 4)
+        {
+            if (fullMask) memcpy(row, clear, 4);
+            else for (int i = 0; i < 4; i++) if (SW.colorMask[i]) row[i] = clear[i];
+        }
+    }
+}
+
+void swGetFloatv(GLenum pname, GLfloat *params)
+{
+    switch (pname)
+    {
+        case GL_PROJECTION_MATRIX: memcpy(params, SW.stack[0][SW.stackDepth[0]], 16*sizeof(float)); break;
+        case GL_MODELVIEW_MATRIX: memcpy(params, SW.stack[1][SW.stackDepth[1]], 16*sizeof(float)); break;
+        case GL_TEXTURE_MATRIX: memcpy(params, SW.stack[2][SW.stackDepth[2]], 16*sizeof(float)); break;
+        case GL_LINE_WIDTH: params[0] = SW.lineWidth; break;
+        case GL_COLOR_CLEAR_VALUE: memcpy(params, SW.clearColor, 4*sizeof(float)); break;
+        default: break;
+    }
+}
+
+// Unknown names return an empty string instead of NULL, so callers can print them as is
+const GLubyte *swGetString(GLenum name)
+{
+    switch (name)
+    {
+        case GL_VENDOR: return (const GLubyte *)"raylib";
+        case GL_RENDERER: return (const GLubyte *)"rlsw (software rasterizer)";
+        case GL_VERSION: return (const GLubyte *)"1.1 rlsw 1.0";
+        default: return (const GLubyte *)"";
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Matrix stacks
+//----------------------------------------------------------------------------------
+
+void swMatrixMode(GLenum mode)
+{
+    switch (mode)
+    {
+        case GL_PROJECTION: SW.matrixMode = 0; break;
+        case GL_MODELVIEW: SW.matrixMode = 1; break;
+        case GL_TEXTURE: SW.matrixMode = 2; break;
+        default: break;
+    }
+}
+
+void swPushMatrix(void)
+{
+    int *depth = &SW.stackDepth[SW.matrixMode];
+    if (*depth + 1 >= SW_MAX_MATRIX_STACK_SIZE) return;
+
+    memcpy(SW.stack[SW.matrixMode][*depth + 1], SW.stack[SW.matrixMode][*depth], 16*sizeof(float));
+    (*depth)++;
+}
+
+void swPopMatrix(void)
+{
+    if (SW.stackDepth[SW.matrixMode] > 0) SW.stackDepth[SW.matrixMode]--;
+    SW.mvpDirty = true;
+}
+
+void swLoadIdentity(void)
+{
+    float *top = SW.stack[SW.matrixMode][SW.stackDepth[SW.matrixMode]];
+    memset(top, 0, 16*sizeof(float));
+    top[0] = top[5] = top[10] = top[15] = 1.0f;
+    SW.mvpDirty = true;
+}
+
+void swMultMatrixf(const GLfloat *m)
+{
+    swMultCurrent(m);
+}
+
+void swTranslatef(GLfloat x, GLfloat y, GLfloat z)
+{
+    float m[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, x, y, z, 1 };
+    swMultCurrent(m);
+}
+
+void swRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+{
+    float length = sqrtf(x*x + y*y + z*z);
+    if (length == 0.0f) return;
+    x /= length; y /= length; z /= length;
+
+    float radians = angle*3.14159265358979323846f/180.0f;
+    float c = cosf(radians);
+    float s = sinf(radians);
+    float t = 1.0f - c;
+
+    float m[16] = {
+        x*x*t + c,   y*x*t + z*s, z*x*t - y*s, 0,
+        x*y*t - z*s, y*y*t + c,   z*y*t + x*s, 0,
+        x*z*t + y*s, y*z*t - x*s, z*z*t + c,   0,
+        0,           0,           0,           1
+    };
+    swMultCurrent(m);
+}
+
+void swScalef(GLfloat x, GLfloat y, GLfloat z)
+{
+    float m[16] = { x, 0, 0, 0, 0, y, 0, 0, 0, 0, z, 0, 0, 0, 0, 1 };
+    swMultCurrent(m);
+}
+
+void swOrtho(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble znear, GLdouble zfar)
+{
+    float rl = (float)(right - left);
+    float tb = (float)(top - bottom);
+    float fn = (float)(zfar - znear);
+
+    float m[16] = {
+        2.0f/rl, 0, 0, 0,
+        0, 2.0f/tb, 0, 0,
+        0, 0, -2.0f/fn, 0,
+        -(float)(right + left)/rl, -(float)(top + bottom)/tb, -(float)(zfar + znear)/fn, 1
+    };
+    swMultCurrent(m);
+}
+
+void swFrustum(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble znear, GLdouble zfar)
+{
+    float rl = (float)(right - left);
+    float tb = (float)(top - bottom);
+    float fn = (float)(zfar - znear);
+
+    float m[16] = {
+        (float)(znear*2.0)/rl, 0, 0, 0,
+        0, (float)(znear*2.0)/tb, 0, 0,
+        (float)(right + left)/rl, (float)(top + bottom)/tb, -(float)(zfar + znear)/fn, -1,
+        0, 0, -(float)(zfar*znear*2.0)/fn, 0
+    };
+    swMultCurrent(m);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Immediate mode
+//----------------------------------------------------------------------------------
+
+void swBegin(GLenum mode)
+{
+    SW.primitiveMode = mode;
+    SW.vertexCount = 0;
+
+    if (SW.mvpDirty)
+    {
+        swMatrixMultiply(SW.mvp, SW.stack[0][SW.stackDepth[0]], SW.stack[1][SW.stackDepth[1]]);
+        SW.mvpDirty = false;
+    }
+}
+
+// Incomplete primitives are discarded, like on OpenGL
+void swEnd(void)
+{
+    SW.vertexCount = 0;
+}
+
+void swVertex2i(GLint x, GLint y) { swVertex3f((float)x, (float)y, 0.0f); }
+void swVertex2f(GLfloat x, GLfloat y) { swVertex3f(x, y, 0.0f); }
+
+void swVertex3f(GLfloat x, GLfloat y, GLfloat z)
+{
+    swVertex *vertex = &SW.primitive[SW.vertexCount++];
+    swTransformVertex(x, y, z, 1.0f, vertex);
+
+    switch (SW.primitiveMode)
+    {
+        case GL_LINES:
+        {
+            if (SW.vertexCount == 2)
+            {
+                swRasterizeLine(&SW.primitive[0], &SW.primitive[1]);
+                SW.vertexCount = 0;
+            }
+        } break;
+        case GL_TRIANGLES:
+        {
+            if (SW.vertexCount == 3)
+            {
+                swRasterizeTriangle(&SW.primitive[0], &SW.primitive[1], &SW.primitive[2], SW.primitive[2].color);
+                SW.vertexCount = 0;
+            }
+        } break;
+        case GL_QUADS:
+        {
+            if (SW.vertexCount == 4)
+            {
+                // The last vertex of the quad provides the flat shading color for both halves
+                swRasterizeTriangle(&SW.primitive[0], &SW.primitive[1], &SW.primitive[2], SW.primitive[3].color);
+                swRasterizeTriangle(&SW.primitive[2], &SW.primitive[3], &SW.primitive[0], SW.primitive[3].color);
+                SW.vertexCount = 0;
+            }
+        } break;
+        default: SW.vertexCount = 0; break;
+    }
+}
+
+void swTexCoord2f(GLfloat s, GLfloat t)
+{
+    SW.texcoord[0] = s;
+    SW.texcoord[1] = t;
+}
+
+// Normals are accepted for API compatibility, there is no lighting
+void swNormal3f(GLfloat nx, GLfloat ny, GLfloat nz) { (void)nx; (void)ny; (void)nz; }
+
+void swColor4ub(GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha)
+{
+    SW.color[0] = red/255.0f;
+    SW.color[1] = green/255.0f;
+    SW.color[2] = blue/255.0f;
+    SW.color[3] = alpha/255.0f;
+}
+
+void swColor3f(GLfloat red, GLfloat green, GLfloat blue) { swColor4f(red, green, blue, 1.0f); }
+
+void swColor4f(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    SW.color[0] = red;
+    SW.color[1] = green;
+    SW.color[2] = blue;
+    SW.color[3] = alpha;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Vertex arrays
+//----------------------------------------------------------------------------------
+
+static int swClientArrayIndex(GLenum array)
+{
+    switch (array)
+    {
+        case GL_VERTEX_ARRAY: return SW_ARRAY_VERTEX;
+        case GL_TEXTURE_COORD_ARRAY: return SW_ARRAY_TEXCOORD;
+        case GL_COLOR_ARRAY: return SW_ARRAY_COLOR;
+        case GL_NORMAL_ARRAY: return SW_ARRAY_NORMAL;
+        default: return -1;
+    }
+}
+
+static void swSetArray(int index, GLint size, GLenum type, GLsizei stride, const GLvoid *pointer)
+{
+    int componentSize = (type == GL_UNSIGNED_BYTE)? 1 : 4;
+
+    SW.arrays[index].size = size;
+    SW.arrays[index].type = type;
+    SW.arrays[index].stride = (stride > 0)? stride : size*componentSize;
+    SW.arrays[index].pointer = (const unsigned char *)pointer;
+}
+
+// Feed one array element through the immediate mode path
+static void swArrayElement(int index)
+{
+    const swArray *color = &SW.arrays[SW_ARRAY_COLOR];
+    if (color->enabled && (color->pointer != NULL))
+    {
+        const unsigned char *element = color->pointer + (size_t)index*color->stride;
+        if (color->type == GL_UNSIGNED_BYTE) swColor4ub(element[0], element[1], element[2], (color->size == 4)? element[3] : 255);
+        else
+        {
+            const float *value = (const float *)element;
+            swColor4f(value[0], value[1], value[2], (color->size == 4)? value[3] : 1.0f);
+        }
+    }
+
+    const swArray *texcoord = &SW.arrays[SW_ARRAY_TEXCOORD];
+    if (texcoord->enabled && (texcoord->pointer != NULL))
+    {
+        const float *value = (const float *)(texcoord->pointer + (size_t)index*texcoord->stride);
+        swTexCoord2f(value[0], value[1]);
+    }
+
+    const swArray *vertex = &SW.arrays[SW_ARRAY_VERTEX];
+    const float *value = (const float *)(vertex->pointer + (size_t)index*vertex->stride);
+    swVertex3f(value[0], value[1], (vertex->size > 2)? value[2] : 0.0f);
+}
+
+void swEnableClientState(GLenum array)
+{
+    int index = swClientArrayIndex(array);
+    if (index >= 0) SW.arrays[index].enabled = true;
+}
+
+void swDisableClientState(GLenum array)
+{
+    int index = swClientArrayIndex(array);
+    if (index >= 0) SW.arrays[index].enabled = false;
+}
+
+void swVertexPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer) { swSetArray(SW_ARRAY_VERTEX, size, type, stride, pointer); }
+void swTexCoordPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer) { swSetArray(SW_ARRAY_TEXCOORD, size, type, stride, pointer); }
+void swColorPointer(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer) { swSetArray(SW_ARRAY_COLOR, size, type, stride, pointer); }
+void swNormalPointer(GLenum type, GLsizei stride, const GLvoid *pointer) { swSetArray(SW_ARRAY_NORMAL, 3, type, stride, pointer); }
+
+// NOTE: Only float vertex and texcoord arrays are supported, colors can be float or unsigned byte
+void swDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    if (!SW.arrays[SW_ARRAY_VERTEX].enabled || (SW.arrays[SW_ARRAY_VERTEX].pointer == NULL)) return;
+
+    swBegin(mode);
+    for (int i = 0; i < count; i++) swArrayElement(first + i);
+    swEnd();
+}
+
+void swDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices)
+{
+    if (!SW.arrays[SW_ARRAY_VERTEX].enabled || (SW.arrays[SW_ARRAY_VERTEX].pointer == NULL)) return;
+
+    swBegin(mode);
+    for (int i = 0; i < count; i++)
+    {
+        int index = 0;
+        if (type == GL_UNSIGNED_BYTE) index = ((const unsigned char *)indices)[i];
+        else if (type == GL_UNSIGNED_SHORT) index = ((const unsigned short *)indices)[i];
+        else if (type == GL_UNSIGNED_INT) index = (int)((const unsigned int *)indices)[i];
+        swArrayElement(index);
+    }
+    swEnd();
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Textures
+//----------------------------------------------------------------------------------
+
+void swGenTextures(GLsizei n, GLuint *textures)
+{
+    int next = 0;
+    for (int i = 0; i < n; i++)
+    {
+        textures[i] = 0;
+        while ((next < SW_MAX_TEXTURES) && SW.textures[next].used) next++;
+        if (next == SW_MAX_TEXTURES) continue;
+
+        SW.textures[next] = (swTexture){ 0 };
+        SW.textures[next].used = true;
+        SW.textures[next].minFilter = GL_NEAREST_MIPMAP_LINEAR;
+        SW.textures[next].magFilter = GL_LINEAR;
+        SW.textures[next].wrapS = GL_REPEAT;
+        SW.textures[next].wrapT = GL_REPEAT;
+        textures[i] = next + 1;
+    }
+}
+
+void swDeleteTextures(GLsizei n, const GLuint *textures)
+{
+    for (int i = 0; i < n; i++)
+    {
+        swTexture *texture = swGetTexture(textures[i]);
+        if (texture == NULL) continue;
+
+        free(texture->pixels);
+        *texture = (swTexture){ 0 };
+        if (SW.boundTexture == textures[i]) SW.boundTexture = 0;
+    }
+}
+
+void swBindTexture(GLenum target, GLuint texture)
+{
+    if (target == GL_TEXTURE_2D) SW.boundTexture = texture;
+}
+
+void swTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels)
+{
+    (void)internalformat; (void)border;
+
+    swTexture *texture = swGetTexture(SW.boundTexture);
+    if ((target != GL_TEXTURE_2D) || (level != 0) || (texture == NULL) || (width <= 0) || (height <= 0)) return;
+
+    unsigned char *storage = (unsigned char *)calloc((size_t)width*height, 4);
+    if (storage == NULL) return;
+
+    free(texture->pixels);
+    texture->pixels = storage;
+    texture->width = width;
+    texture->height = height;
+
+    if (pixels != NULL) swTexSubImage2D(target, level, 0, 0, width, height, format, type, pixels);
+}
+
+void swTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels)
+{
+    swTexture *texture = swGetTexture(SW.boundTexture);
+    if ((target != GL_TEXTURE_2D) || (level != 0) || (texture == NULL) || (texture->pixels == NULL) || (pixels == NULL)) return;
+    if ((xoffset < 0) || (yoffset < 0) || (xoffset + width > texture->width) || (yoffset + height > texture->height)) return;
+
+    int pixelSize = swGetPixelSize(format, type);
+    if (pixelSize == 0) return;
+
+    int rowSize = width*pixelSize;
+    int rowStride = (rowSize + SW.unpackAlignment - 1)/SW.unpackAlignment*SW.unpackAlignment;
+
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *src = (const unsigned char *)pixels + (size_t)y*rowStride;
+        unsigned char *dst = texture->pixels + ((size_t)(yoffset + y)*texture->width + xoffset)*4;
+        for (int x = 0; x < width; x++, src += pixelSize, dst += 4) swUnpackPixel(src, format, type, dst);
+    }
+}
+
+void swTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    swTexture *texture = swGetTexture(SW.boundTexture);
+    if ((target != GL_TEXTURE_2D) || (texture == NULL)) return;
+
+    switch (pname)
+    {
+        case GL_TEXTURE_MIN_FILTER: texture->minFilter = param; break;
+        case GL_TEXTURE_MAG_FILTER: texture->magFilter = param; break;
+        case GL_TEXTURE_WRAP_S: texture->wrapS = param; break;
+        case GL_TEXTURE_WRAP_T: texture->wrapT = param; break;
+        default: break;
+    }
+}
+
+void swGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, GLvoid *pixels)
+{
+    const swTexture *texture = swGetTexture(SW.boundTexture);
+    if ((target != GL_TEXTURE_2D) || (level != 0) || (texture == NULL) || (texture->pixels == NULL)) return;
+
+    int pixelSize = swGetPixelSize(format, type);
+    if (pixelSize == 0) return;
+
+    int rowSize = texture->width*pixelSize;
+    int rowStride = (rowSize + SW.packAlignment - 1)/SW.packAlignment*SW.packAlignment;
+
+    for (int y = 0; y < texture->height; y++)
+    {
+        const unsigned char *src = texture->pixels + (size_t)y*texture->width*4;
+        unsigned char *dst = (unsigned char *)pixels + (size_t)y*rowStride;
+        for (int x = 0; x < texture->width; x++, src += 4, dst += pixelSize) swPackPixel(src, format, type, dst);
+    }
+}
+
+// Read back the color buffer, rows bottom-up like OpenGL
+void swReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels)
+{
+    int pixelSize = swGetPixelSize(format, type);
+    if ((pixelSize == 0) || (SW.colorBuffer == NULL)) return;
+
+    int rowSize = width*pixelSize;
+    int rowStride = (rowSize + SW.packAlignment - 1)/SW.packAlignment*SW.packAlignment;
+
+    for (int row = 0; row < height; row++)
+    {
+        unsigned char *dst = (unsigned char *)pixels + (size_t)row*rowStride;
+        for (int col = 0; col < width; col++, dst += pixelSize)
+        {
+            int px = x + col;
+            int py = y + row;
+            if ((px < 0) || (py < 0) || (px >= SW.width) || (py >= SW.height)) continue;
+            swPackPixel(SW.colorBuffer + ((size_t)py*SW.width + px)*4, format, type, dst);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module specific Functions Definition
+//----------------------------------------------------------------------------------
+
+// Column-major 4x4 multiply: result = left*right
+static void swMatrixMultiply(float *result, const float *left, const float *right)
+{
+    float m[16];
+    for (int c = 0; c < 4; c++)
+    {
+        for (int r = 0; r < 4; r++)
+        {
+            m[c*4 + r] = left[0*4 + r]*right[c*4 + 0] + left[1*4 + r]*right[c*4 + 1] +
+                         left[2*4 + r]*right[c*4 + 2] + left[3*4 + r]*right[c*4 + 3];
+        }
+    }
+    memcpy(result, m, sizeof(m));
+}
+
+// Multiply the top of the current stack by m, on the right like OpenGL
+static void swMultCurrent(const float *m)
+{
+    float *top = SW.stack[SW.matrixMode][SW.stackDepth[SW.matrixMode]];
+    swMatrixMultiply(top, top, m);
+    SW.mvpDirty = true;
+}
+
+static swTexture *swGetTexture(unsigned int id)
+{
+    if ((id == 0) || (id > SW_MAX_TEXTURES) || !SW.textures[id - 1].used) return NULL;
+    return &SW.textures[id - 1];
+}
+
+// Bytes per pixel of a format/type pair, 0 if not supported
+static int swGetPixelSize(int format, int type)
+{
+    if ((type == GL_UNSIGNED_SHORT_5_6_5) || (type == GL_UNSIGNED_SHORT_5_5_5_1) || (type == GL_UNSIGNED_SHORT_4_4_4_4)) return 2;
+    if (type != GL_UNSIGNED_BYTE) return 0;
+
+    switch (format)
+    {
+        case GL_ALPHA:
+        case GL_LUMINANCE: return 1;
+        case GL_LUMINANCE_ALPHA: return 2;
+        case GL_RGB: return 3;
+        case GL_RGBA: return 4;
+        default: return 0;
+    }
+}
+
+static void swUnpackPixel(const unsigned char *src, int format, int type, unsigned char *rgba)
+{
+    if (type == GL_UNSIGNED_SHORT_5_6_5)
+    {
+        unsigned short value = (unsigned short)(src[0] | (src[1] << 8));
+        rgba[0] = (unsigned char)(((value >> 11) & 0x1f)*255/31);
+        rgba[1] = (unsigned char)(((value >> 5) & 0x3f)*255/63);
+        rgba[2] = (unsigned char)((value & 0x1f)*255/31);
+        rgba[3] = 255;
+        return;
+    }
+    if (type == GL_UNSIGNED_SHORT_5_5_5_1)
+    {
+        unsigned short value = (unsigned short)(src[0] | (src[1] << 8));
+        rgba[0] = (unsigned char)(((value >> 11) & 0x1f)*255/31);
+        rgba[1] = (unsigned char)(((value >> 6) & 0x1f)*255/31);
+        rgba[2] = (unsigned char)(((value >> 1) & 0x1f)*255/31);
+        rgba[3] = (value & 0x1)? 255 : 0;
+        return;
+    }
+    if (type == GL_UNSIGNED_SHORT_4_4_4_4)
+    {
+        unsigned short value = (unsigned short)(src[0] | (src[1] << 8));
+        rgba[0] = (unsigned char)(((value >> 12) & 0xf)*17);
+        rgba[1] = (unsigned char)(((value >> 8) & 0xf)*17);
+        rgba[2] = (unsigned char)(((value >> 4) & 0xf)*17);
+        rgba[3] = (unsigned char)((value & 0xf)*17);
+        return;
+    }
+
+    switch (format)
+    {
+        case GL_ALPHA: rgba[0] = rgba[1] = rgba[2] = 255; rgba[3] = src[0]; break;
+        case GL_LUMINANCE: rgba[0] = rgba[1] = rgba[2] = src[0]; rgba[3] = 255; break;
+        case GL_LUMINANCE_ALPHA: rgba[0] = rgba[1] = rgba[2] = src[0]; rgba[3] = src[1]; break;
+        case GL_RGB: rgba[0] = src[0]; rgba[1] = src[1]; rgba[2] = src[2]; rgba[3] = 255; break;
+        case GL_RGBA: memcpy(rgba, src, 4); break;
+        default: break;
+    }
+}
+
+static void swPackPixel(const unsigned char *rgba, int format, int type, unsigned char *dst)
+{
+    unsigned short value = 0;
+
+    if (type == GL_UNSIGNED_SHORT_5_6_5) value = (unsigned short)(((rgba[0]*31/255) << 11) | ((rgba[1]*63/255) << 5) | (rgba[2]*31/255));
+    else if (type == GL_UNSIGNED_SHORT_5_5_5_1) value = (unsigned short)(((rgba[0]*31/255) << 11) | ((rgba[1]*31/255) << 6) | ((rgba[2]*31/255) << 1) | (rgba[3] > 127));
+    else if (type == GL_UNSIGNED_SHORT_4_4_4_4) value = (unsigned short)(((rgba[0]/17) << 12) | ((rgba[1]/17) << 8) | ((rgba[2]/17) << 4) | (rgba[3]/17));
+    else
+    {
+        switch (format)
+        {
+            case GL_ALPHA: dst[0] = rgba[3]; break;
+            case GL_LUMINANCE: dst[0] = rgba[0]; break;
+            case GL_LUMINANCE_ALPHA: dst[0] = rgba[0]; dst[1] = rgba[3]; break;
+            case GL_RGB: memcpy(dst, rgba, 3); break;
+            case GL_RGBA: memcpy(dst, rgba, 4); break;
+            default: break;
+        }
+        return;
+    }
+
+    dst[0] = (unsigned char)(value & 0xff);
+    dst[1] = (unsigned char)(value >> 8);
+}
+
+// Apply a wrap mode to an integer texel coordinate
+static inline int swWrap(int coord, int size, int mode)
+{
+    switch (mode)
+    {
+        case GL_REPEAT:
+        {
+            coord %= size;
+            return (coord < 0)? coord + size : coord;
+        }
+        case GL_MIRRORED_REPEAT:
+        {
+            int period = size*2;
+            coord %= period;
+            if (coord < 0) coord += period;
+            return (coord < size)? coord : period - 1 - coord;
+        }
+        default: return (coord < 0)? 0 : (coord >= size)? size - 1 : coord;     // GL_CLAMP, GL_CLAMP_TO_EDGE
+    }
+}
+
+// Sample a texture into a normalized color
+static void swSampleTexture(const swTexture *texture, float s, float t, int filter, float *color)
+{
+    float u = s*texture->width;
+    float v = t*texture->height;
+
+    if ((filter == GL_NEAREST) || (filter == GL_NEAREST_MIPMAP_NEAREST) || (filter == GL_NEAREST_MIPMAP_LINEAR))
+    {
+        int x = swWrap((int)floorf(u), texture->width, texture->wrapS);
+        int y = swWrap((int)floorf(v), texture->height, texture->wrapT);
+        const unsigned char *texel = texture->pixels + ((size_t)y*texture->width + x)*4;
+        for (int i = 0; i < 4; i++) color[i] = texel[i]/255.0f;
+        return;
+    }
+
+    u -= 0.5f;
+    v -= 0.5f;
+    float fu = floorf(u);
+    float fv = floorf(v);
+    float du = u - fu;
+    float dv = v - fv;
+    int x0 = swWrap((int)fu, texture->width, texture->wrapS);
+    int x1 = swWrap((int)fu + 1, texture->width, texture->wrapS);
+    int y0 = swWrap((int)fv, texture->height, texture->wrapT);
+    int y1 = swWrap((int)fv + 1, texture->height, texture->wrapT);
+
+    const unsigned char *t00 = texture->pixels + ((size_t)y0*texture->width + x0)*4;
+    const unsigned char *t10 = texture->pixels + ((size_t)y0*texture->width + x1)*4;
+    const unsigned char *t01 = texture->pixels + ((size_t)y1*texture->width + x0)*4;
+    const unsigned char *t11 = texture->pixels + ((size_t)y1*texture->width + x1)*4;
+
+    for (int i = 0; i < 4; i++)
+    {
+        float top = t00[i] + (t10[i] - t00[i])*du;
+        float bottom = t01[i] + (t11[i] - t01[i])*du;
+        color[i] = (top + (bottom - top)*dv)/255.0f;
+    }
+}
+
+static inline float swBlendFactor(int factor, const float *src, const float *dst, int channel)
+{
+    switch (factor)
+    {
+        case GL_ZERO: return 0.0f;
+        case GL_ONE: return 1.0f;
+        case GL_SRC_COLOR: return src[channel];
+        case GL_ONE_MINUS_SRC_COLOR: return 1.0f - src[channel];
+        case GL_SRC_ALPHA: return src[3];
+        case GL_ONE_MINUS_SRC_ALPHA: return 1.0f - src[3];
+        case GL_DST_ALPHA: return dst[3];
+        case GL_ONE_MINUS_DST_ALPHA: return 1.0f - dst[3];
+        case GL_DST_COLOR: return dst[channel];
+        case GL_ONE_MINUS_DST_COLOR: return 1.0f - dst[channel];
+        case GL_SRC_ALPHA_SATURATE:
+        {
+            if (channel == 3) return 1.0f;
+            return (src[3] < 1.0f - dst[3])? src[3] : 1.0f - dst[3];
+        }
+        default: return 0.0f;
+    }
+}
+
+// Blend and write a fragment, the position must already be inside the clip rectangle
+static void swWriteFragment(int x, int y, const float *color)
+{
+    unsigned char *pixel = SW.colorBuffer + ((size_t)y*SW.width + x)*4;
+    float result[4];
+
+    if (SW.blend)
+    {
+        // Common alpha blending cases skip the full equation
+        if ((SW.srcFactor == GL_SRC_ALPHA) && (SW.dstFactor == GL_ONE_MINUS_SRC_ALPHA))
+        {
+            if (color[3] <= 0.0f) return;
+            if (color[3] >= 1.0f) memcpy(result, color, sizeof(result));
+            else
+            {
+                for (int i = 0; i < 4; i++) result[i] = color[i]*color[3] + pixel[i]/255.0f*(1.0f - color[3]);
+            }
+        }
+        else
+        {
+            float dst[4] = { pixel[0]/255.0f, pixel[1]/255.0f, pixel[2]/255.0f, pixel[3]/255.0f };
+            for (int i = 0; i < 4; i++)
+            {
+                result[i] = color[i]*swBlendFactor(SW.srcFactor, color, dst, i) + dst[i]*swBlendFactor(SW.dstFactor, color, dst, i);
+            }
+        }
+    }
+    else memcpy(result, color, sizeof(result));
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (!SW.colorMask[i]) continue;
+        float value = (result[i] < 0.0f)? 0.0f : (result[i] > 1.0f)? 1.0f : result[i];
+        pixel[i] = (unsigned char)(value*255.0f + 0.5f);
+    }
+}
+
+// Intersection of the viewport, the scissor rectangle (if enabled) and the color buffer, max exclusive
+static void swGetClipRect(int *x0, int *y0, int *x1, int *y1)
+{
+    *x0 = (SW.viewport[0] > 0)? SW.viewport[0] : 0;
+    *y0 = (SW.viewport[1] > 0)? SW.viewport[1] : 0;
+    *x1 = (SW.viewport[0] + SW.viewport[2] < SW.width)? SW.viewport[0] + SW.viewport[2] : SW.width;
+    *y1 = (SW.viewport[1] + SW.viewport[3] < SW.height)? SW.viewport[1] + SW.viewport[3] : SW.height;
+
+    if (SW.scissorTest)
+    {
+        if (SW.scissor[0] > *x0) *x0 = SW.scissor[0];
+        if (SW.scissor[1] > *y0) *y0 = SW.scissor[1];
+        if (SW.scissor[0] + SW.scissor[2] < *x1) *x1 = SW.scissor[0] + SW.scissor[2];
+        if (SW.scissor[1] + SW.scissor[3] < *y1) *y1 = SW.scissor[1] + SW.scissor[3];
+    }
+}
+
+// Transform a vertex to window coordinates and latch the current attributes
+static void swTransformVertex(float x, float y, float z, float w, swVertex *out)
+{
+    const float *m = SW.mvp;
+    float cx = m[0]*x + m[4]*y + m[8]*z + m[12]*w;
+    float cy = m[1]*x + m[5]*y + m[9]*z + m[13]*w;
+    float cw = m[3]*x + m[7]*y + m[11]*z + m[15]*w;
+
+    out->valid = (cw > 0.0f);
+    out->invW = out->valid? 1.0f/cw : 0.0f;
+    out->x = SW.viewport[0] + (cx*out->invW + 1.0f)*0.5f*SW.viewport[2];
+    out->y = SW.viewport[1] + (cy*out->invW + 1.0f)*0.5f*SW.viewport[3];
+    out->texcoord[0] = SW.texcoord[0];
+    out->texcoord[1] = SW.texcoord[1];
+    memcpy(out->color, SW.color, sizeof(out->color));
+}
+
+// Compute the fragment color at barycentric weights (already perspective-corrected)
+static inline void swShadeFragment(const swVertex *v0, const swVertex *v1, const swVertex *v2, float b0, float b1, float b2,
+                                   const float *flatColor, const swTexture *texture, int filter, float *color)
+{
+    if (flatColor != NULL) memcpy(color, flatColor, 4*sizeof(float));
+    else for (int i = 0; i < 4; i++) color[i] = v0->color[i]*b0 + v1->color[i]*b1 + v2->color[i]*b2;
+
+    if (texture != NULL)
+    {
+        float texel[4];
+        float s = v0->texcoord[0]*b0 + v1->texcoord[0]*b1 + v2->texcoord[0]*b2;
+        float t = v0->texcoord[1]*b0 + v1->texcoord[1]*b1 + v2->texcoord[1]*b2;
+        swSampleTexture(texture, s, t, filter, texel);
+        for (int i = 0; i < 4; i++) color[i] *= texel[i];      // GL_MODULATE
+    }
+}
+
+static const swTexture *swGetActiveTexture(void)
+{
+    if (!SW.texture2D) return NULL;
+
+    const swTexture *texture = swGetTexture(SW.boundTexture);
+    return ((texture != NULL) && (texture->pixels != NULL))? texture : NULL;
+}
+
+// Lines are stepped one pixel at a time along their major axis, the last pixel is left out like on OpenGL
+static void swRasterizeLine(const swVertex *v0, const swVertex *v1)
+{
+    if (!v0->valid || !v1->valid) return;
+
+    int clipX0, clipY0, clipX1, clipY1;
+    swGetClipRect(&clipX0, &clipY0, &clipX1, &clipY1);
+
+    float dx = v1->x - v0->x;
+    float dy = v1->y - v0->y;
+    float adx = fabsf(dx);
+    float ady = fabsf(dy);
+    int steps = (int)((adx > ady)? adx : ady);
+    if (steps == 0) steps = 1;
+
+    bool xMajor = (adx >= ady);
+    int thickness = (int)(SW.lineWidth + 0.5f);
+    if (thickness < 1) thickness = 1;
+
+    const swTexture *texture = swGetActiveTexture();
+    int filter = (texture != NULL)? texture->magFilter : GL_NEAREST;
+    const float *flatColor = (SW.shadeModel == GL_FLAT)? v1->color : NULL;
+
+    for (int i = 0; i < steps; i++)
+    {
+        float t = (i + 0.5f)/steps;
+        int x = (int)floorf(v0->x + dx*t);
+        int y = (int)floorf(v0->y + dy*t);
+
+        // Perspective-correct position along the line
+        float w0 = (1.0f - t)*v0->invW;
+        float w1 = t*v1->invW;
+        float sum = w0 + w1;
+        float color[4];
+        swShadeFragment(v0, v1, v1, w0/sum, w1/sum, 0.0f, flatColor, texture, filter, color);
+
+        // Wide lines grow along the minor axis
+        for (int k = 0; k < thickness; k++)
+        {
+            int px = xMajor? x : x - (thickness - 1)/2 + k;
+            int py = xMajor? y - (thickness - 1)/2 + k : y;
+            if ((px < clipX0) || (py < clipY0) || (px >= clipX1) || (py >= clipY1)) continue;
+            swWriteFragment(px, py, color);
+        }
+    }
+}
+
+// Edge function in fixed-point, positive on the left of a->b
+static inline long long swEdge(long long ax, long long ay, long long bx, long long by, long long px, long long py)
+{
+    return (bx - ax)*(py - ay) - (by - ay)*(px - ax);
+}
+
+static void swRasterizeTriangle(const swVertex *v0, const swVertex *v1, const swVertex *v2, const float *flatColor)
+{
+    if (!v0->valid || !v1->valid || !v2->valid || (SW.colorBuffer == NULL)) return;
+
+    if (SW.polygonMode == GL_LINE)
+    {
+        swRasterizeLine(v0, v1);
+        swRasterizeLine(v1, v2);
+        swRasterizeLine(v2, v0);
+        return;
+    }
+
+    // Snap to fixed-point so shared edges are evaluated exactly the same by both triangles
+    long long x[3], y[3];
+    const swVertex *vertices[3] = { v0, v1, v2 };
+    for (int i = 0; i < 3; i++)
+    {
+        float fx = vertices[i]->x*SW_SUBPIXEL_ONE;
+        float fy = vertices[i]->y*SW_SUBPIXEL_ONE;
+        if ((fabsf(fx) > SW_MAX_COORD) || (fabsf(fy) > SW_MAX_COORD)) return;
+        x[i] = (long long)floorf(fx + 0.5f);
+        y[i] = (long long)floorf(fy + 0.5f);
+    }
+
+    long long area = swEdge(x[0], y[0], x[1], y[1], x[2], y[2]);
+    if (area == 0) return;
+
+    if (SW.cullFace)
+    {
+        bool front = (SW.frontFace == GL_CCW)? (area > 0) : (area < 0);
+        if ((SW.cullMode == GL_FRONT_AND_BACK) || ((SW.cullMode == GL_BACK) && !front) || ((SW.cullMode == GL_FRONT) && front)) return;
+    }
+
+    // Rasterize counter-clockwise only
+    if (area < 0)
+    {
+        const swVertex *swap = vertices[1]; vertices[1] = vertices[2]; vertices[2] = swap;
+        long long tx = x[1]; x[1] = x[2]; x[2] = tx;
+        long long ty = y[1]; y[1] = y[2]; y[2] = ty;
+        area = -area;
+    }
+
+    int clipX0, clipY0, clipX1, clipY1;
+    swGetClipRect(&clipX0, &clipY0, &clipX1, &clipY1);
+
+    long long minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+    for (int i = 1; i < 3; i++)
+    {
+        if (x[i] < minX) minX = x[i];
+        if (x[i] > maxX) maxX = x[i];
+        if (y[i] < minY) minY = y[i];
+        if (y[i] > maxY) maxY = y[i];
+    }
+
+    int startX = (int)(minX >> SW_SUBPIXEL_BITS);
+    int startY = (int)(minY >> SW_SUBPIXEL_BITS);
+    int endX = (int)((maxX + SW_SUBPIXEL_ONE - 1) >> SW_SUBPIXEL_BITS);
+    int endY = (int)((maxY + SW_SUBPIXEL_ONE - 1) >> SW_SUBPIXEL_BITS);
+    if (startX < clipX0) startX = clipX0;
+    if (startY < clipY0) startY = clipY0;
+    if (endX > clipX1) endX = clipX1;
+    if (endY > clipY1) endY = clipY1;
+    if ((startX >= endX) || (startY >= endY)) return;
+
+    // Tie-breaking: a pixel center exactly on an edge belongs to the triangle only if the edge
+    // points down, or right when horizontal. The neighbour shares the edge in the opposite direction,
+    // the bias turns the rejected ties negative so the inside test is a plain sign check
+    long long bias[3];
+    for (int i = 0; i < 3; i++)
+    {
+        int a = (i + 1)%3, b = (i + 2)%3;
+        long long dx = x[b] - x[a], dy = y[b] - y[a];
+        bias[i] = ((dy < 0) || ((dy == 0) && (dx > 0)))? 0 : -1;
+    }
+
+    // Edge functions at the first pixel center and their steps per pixel
+    long long px = ((long long)startX << SW_SUBPIXEL_BITS) + SW_SUBPIXEL_ONE/2;
+    long long py = ((long long)startY << SW_SUBPIXEL_BITS) + SW_SUBPIXEL_ONE/2;
+    long long rowEdge[3], stepX[3], stepY[3];
+    for (int i = 0; i < 3; i++)
+    {
+        int a = (i + 1)%3, b = (i + 2)%3;
+        rowEdge[i] = swEdge(x[a], y[a], x[b], y[b], px, py) + bias[i];
+        stepX[i] = -(y[b] - y[a])*SW_SUBPIXEL_ONE;
+        stepY[i] = (x[b] - x[a])*SW_SUBPIXEL_ONE;
+    }
+
+    const swTexture *texture = swGetActiveTexture();
+    int filter = GL_NEAREST;
+    if (texture != NULL)
+    {
+        // Pick minification or magnification once per triangle, by comparing texel and pixel areas
+        float ds1 = (vertices[1]->texcoord[0] - vertices[0]->texcoord[0])*texture->width;
+        float dt1 = (vertices[1]->texcoord[1] - vertices[0]->texcoord[1])*texture->height;
+        float ds2 = (vertices[2]->texcoord[0] - vertices[0]->texcoord[0])*texture->width;
+        float dt2 = (vertices[2]->texcoord[1] - vertices[0]->texcoord[1])*texture->height;
+        float texelArea = fabsf(ds1*dt2 - ds2*dt1);
+        float pixelArea = (float)area/(SW_SUBPIXEL_ONE*SW_SUBPIXEL_ONE);
+        filter = (texelArea > pixelArea)? texture->minFilter : texture->magFilter;
+    }
+    if (SW.shadeModel != GL_FLAT) flatColor = NULL;
+
+    // Attributes are constant with an orthographic projection, skip the per-pixel divide then
+    bool affine = (vertices[0]->invW == vertices[1]->invW) && (vertices[1]->invW == vertices[2]->invW);
+    float invArea = 1.0f/(float)area;
+
+    for (int py = startY; py < endY; py++)
+    {
+        long long e0 = rowEdge[0], e1 = rowEdge[1], e2 = rowEdge[2];
+
+        for (int px = startX; px < endX; px++)
+        {
+            if ((e0 >= 0) && (e1 >= 0) && (e2 >= 0))
+            {
+                // Remove the tie-breaking bias before using the edges as weights
+                float b0 = (float)(e0 - bias[0])*invArea;
+                float b1 = (float)(e1 - bias[1])*invArea;
+                float b2 = (float)(e2 - bias[2])*invArea;
+
+                if (!affine)
+                {
+                    b0 *= vertices[0]->invW;
+                    b1 *= vertices[1]->invW;
+                    b2 *= vertices[2]->invW;
+                    float sum = b0 + b1 + b2;
+                    b0 /= sum; b1 /= sum; b2 /= sum;
+                }
+
+                float color[4];
+                swShadeFragment(vertices[0], vertices[1], vertices[2], b0, b1, b2, flatColor, texture, filter, color);
+                swWriteFragment(px, py, color);
+            }
+
+            e0 += stepX[0];
+            e1 += stepX[1];
+            e2 += stepX[2];
+        }
+
+        rowEdge[0] += stepY[0];
+        rowEdge[1] += stepY[1];
+        rowEdge[2] += stepY[2];
+    }
+}
+
+#endif // RLSW_IMPLEMENTATION
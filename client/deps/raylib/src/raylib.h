@@ -1062,6 +1062,7 @@ RLAPI Matrix GetCameraMatrix2D(Camera2D camera);                        // Get c
 // Timing-related functions
 RLAPI void SetTargetFPS(int fps);                                 // Set target FPS (maximum)
 RLAPI float GetFrameTime(void);                                   // Get time in seconds for last frame drawn (delta time)
+RLAPI float GetFrameTimeJitter(void);                             // Get standard deviation of recent frame times in seconds (frame pacing jitter)
 RLAPI double GetTime(void);                                       // Get elapsed time in seconds since InitWindow()
 RLAPI int GetFPS(void);                                           // Get current FPS
 
@@ -1081,6 +1082,7 @@ RLAPI void UnloadRandomSequence(int *sequence);                   // Unload rand
 
 // Misc. functions
 RLAPI void TakeScreenshot(const char *fileName);                  // Takes a screenshot of current screen (filename extension defines format)
+RLAPI void TakeScreenshotAsync(const char *fileName);             // Takes a screenshot of next frame, read back and saved without stalling it (PNG or QOI)
 RLAPI void SetConfigFlags(unsigned int flags);                    // Setup init configuration flags (view FLAGS)
 RLAPI void OpenURL(const char *url);                              // Open URL with default system browser (if available)
 
@@ -19,6 +19,8 @@
 *           - Linux DRM subsystem (KMS mode)
 *       > PLATFORM_ANDROID:
 *           - Android (ARM, ARM64)
+*       > PLATFORM_MEMORY (requires GRAPHICS_API_OPENGL_11_SOFTWARE):
+*           - Headless, frames rendered on CPU into memory (CI, benchmarks)
 *
 *   CONFIGURATION:
 *       #define SUPPORT_DEFAULT_FONT (default)
@@ -41,6 +43,9 @@
 *       #define SUPPORT_PARTIALBUSY_WAIT_LOOP
 *           Use a partial-busy wait loop, in this case frame sleeps for most of the time and runs a busy-wait-loop at the end
 *
+*       #define SUPPORT_PRECISE_FRAME_PACING
+*           On Linux, sleep with clock_nanosleep() until absolute frame deadlines and only busy-wait for the measured oversleep
+*
 *       #define SUPPORT_SCREEN_CAPTURE
 *           Allow automatic screen capture of current screen pressing F12, defined in KeyCallback()
 *
@@ -90,9 +95,9 @@
     #define _XOPEN_SOURCE 500 // Required for: readlink if compiled with c99 without gnu ext.
 #endif
 
-#if (defined(__linux__) || defined(PLATFORM_WEB)) && (_POSIX_C_SOURCE < 199309L)
+#if (defined(__linux__) || defined(PLATFORM_WEB)) && (_POSIX_C_SOURCE < 200112L)
     #undef _POSIX_C_SOURCE
-    #define _POSIX_C_SOURCE 199309L // Required for: CLOCK_MONOTONIC if compiled with c99 without gnu ext.
+    #define _POSIX_C_SOURCE 200112L // Required for: CLOCK_MONOTONIC, clock_nanosleep() if compiled with c99 without gnu ext.
 #endif
 
 #include "raylib.h"                 // Declares module functions
@@ -197,6 +202,18 @@ unsigned int __stdcall timeEndPeriod(unsigned int uPeriod);
     #define CHDIR chdir
 #endif
 
+// Frames are paced on absolute deadlines where clock_nanosleep() is available, unless a full busy wait is requested
+#if defined(SUPPORT_PRECISE_FRAME_PACING) && defined(__linux__) && !defined(SUPPORT_BUSY_WAIT_LOOP)
+    #define PRECISE_FRAME_PACING
+    #include <errno.h>              // Required for: EINTR
+#endif
+
+// Captures are encoded on worker threads where pthreads are available, otherwise once their readback completes
+#if defined(SUPPORT_ASYNC_SCREEN_CAPTURE) && !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    #define CAPTURE_WORKER_THREADS
+    #include <pthread.h>            // Required for: pthread_create(), pthread_join(), pthread_mutex_lock(), pthread_cond_wait()
+#endif
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
@@ -247,6 +264,33 @@ unsigned int __stdcall timeEndPeriod(unsigned int uPeriod);
     #define MAX_AUTOMATION_EVENTS      16384        // Maximum number of automation events to record
 #endif
 
+#ifndef GIF_RECORD_FRAMERATE
+    #define GIF_RECORD_FRAMERATE          10        // Frames per second recorded to GIF
+#endif
+#ifndef GIF_RECORD_BITRATE
+    #define GIF_RECORD_BITRATE            16        // Maximum bit depth of recorded GIF frames
+#endif
+
+#ifndef MAX_FRAME_TIME_SAMPLES
+    #define MAX_FRAME_TIME_SAMPLES       120        // Frame times kept to measure frame pacing jitter
+#endif
+#ifndef FRAME_PACING_INITIAL_SLACK
+    #define FRAME_PACING_INITIAL_SLACK  100000      // Initial time spun before a deadline, in nanoseconds, until oversleep is measured
+#endif
+#ifndef FRAME_PACING_MAX_SLACK
+    #define FRAME_PACING_MAX_SLACK     2000000      // Maximum time spun before a deadline, in nanoseconds
+#endif
+
+#ifndef MAX_CAPTURE_READBACKS
+    #define MAX_CAPTURE_READBACKS          4        // Maximum number of screen readbacks in flight
+#endif
+#ifndef CAPTURE_READBACK_DELAY
+    #define CAPTURE_READBACK_DELAY         2        // Frames between starting a screen readback and reading it, so the GPU is done with it
+#endif
+#ifndef MAX_CAPTURE_QUEUE_JOBS
+    #define MAX_CAPTURE_QUEUE_JOBS         8        // Maximum number of captured frames waiting to be encoded (per worker)
+#endif
+
 // Flags operation macros
 #define FLAG_SET(n, f) ((n) |= (f))
 #define FLAG_CLEAR(n, f) ((n) &= ~(f))
@@ -372,6 +416,73 @@ bool gifRecording = false;           // GIF recording state
 MsfGifState gifState = { 0 };        // MSGIF context state
 #endif
 
+// Recent frame times, to measure jitter
+static float frameTimes[MAX_FRAME_TIME_SAMPLES] = { 0 };
+static int frameTimesNext = 0;
+static int frameTimesCount = 0;
+
+#if defined(PRECISE_FRAME_PACING)
+// Frame deadlines on CLOCK_MONOTONIC, in nanoseconds
+typedef struct FramePacing {
+    unsigned long long deadline;        // End of the current frame (0 until the first paced frame)
+    unsigned long long period;          // Frame period the deadline was computed with
+    long long slack;                    // Wake up this early and spin the rest, follows the measured oversleep
+} FramePacing;
+
+static FramePacing framePacing = { 0, 0, FRAME_PACING_INITIAL_SLACK };
+#endif
+
+#if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+// Captured frame, waiting to be encoded
+typedef struct CaptureJob {
+    unsigned char *pixels;              // RGBA pixel data, freed once processed
+    int width;                          // Frame width
+    int height;                         // Frame height
+    bool bottomUp;                      // Rows as returned by glReadPixels(), flipped on the worker
+    int delay;                          // Frame duration in centiseconds (GIF frames)
+    char fileName[512];                 // File to save, full path
+} CaptureJob;
+
+// Captured frames processed in order, by a worker thread if available
+typedef struct CaptureQueue {
+    CaptureJob jobs[MAX_CAPTURE_QUEUE_JOBS]; // Ring of jobs waiting for the worker
+    int first;                          // Oldest job in the ring
+    int count;                          // Jobs in the ring
+    void (*process)(CaptureJob *job);   // Job processing function, runs on the worker thread
+    bool running;                       // Worker thread is running
+    bool stopping;                      // Worker thread exits once the ring is empty
+    bool dropJobs;                      // Drop captured frames when the ring is full, instead of waiting for the worker
+    int droppedJobs;                    // Frames dropped since the queue started (main thread only)
+    int droppedDelay;                   // Duration of the frames dropped since the last pushed one, added to the next one (main thread only)
+#if defined(CAPTURE_WORKER_THREADS)
+    pthread_t thread;                   // Worker thread
+    pthread_mutex_t mutex;              // Protects the ring and the flags
+    pthread_cond_t changed;             // Signaled when a job is pushed or popped, or the queue stops
+#endif
+} CaptureQueue;
+
+// Screen readback, started at the end of a frame and read a few frames later
+typedef struct CaptureReadback {
+    unsigned int pbo;                   // Pixel buffer, kept for the next captures (0 if not supported)
+    int size;                           // Pixel buffer size in bytes
+    int width;                          // Capture width
+    int height;                         // Capture height
+    unsigned int frame;                 // Frame counter when the readback started
+    bool requested;                     // Waiting for the end of the frame to start
+    bool pending;                       // Waiting for the GPU
+    CaptureQueue *queue;                // Queue receiving the captured frame
+    int delay;                          // Frame duration in centiseconds (GIF frames)
+    char fileName[512];                 // File to save, full path
+} CaptureReadback;
+
+static CaptureReadback captureReadbacks[MAX_CAPTURE_READBACKS] = { 0 };  // Screen readbacks in flight
+static CaptureQueue screenshotQueue = { 0 };                             // Screenshots encoding worker
+#if defined(SUPPORT_GIF_RECORDING)
+static CaptureQueue gifQueue = { 0 };                                    // GIF frames encoding worker
+static bool gifEncoding = false;                                         // GIF recording begun on the encoder (worker only)
+#endif
+#endif
+
 #if defined(SUPPORT_AUTOMATION_EVENTS)
 // Automation events type
 typedef enum AutomationEventType {
@@ -474,6 +585,11 @@ extern int InitPlatform(void);          // Initialize platform (graphics, inputs
 extern void ClosePlatform(void);        // Close platform
 
 static void InitTimer(void);                                // Initialize timer, hi-resolution if available (required by InitPlatform())
+#if defined(PRECISE_FRAME_PACING)
+static unsigned long long GetMonotonicTime(void);           // Get CLOCK_MONOTONIC time in nanoseconds
+static void WaitUntilDeadline(unsigned long long deadline); // Sleep until a CLOCK_MONOTONIC deadline, spinning only for the expected oversleep
+static void WaitFrameDeadline(void);                        // Wait for the end of the current frame, on deadlines one frame period apart
+#endif
 static void SetupFramebuffer(int width, int height);        // Setup main framebuffer (required by InitPlatform())
 static void SetupViewport(int width, int height);           // Set viewport for a provided width and height
 
@@ -484,6 +600,21 @@ static void ScanDirectoryFilesRecursively(const char *basePath, FilePathList *li
 static void RecordAutomationEvent(void); // Record frame events (to internal events array)
 #endif
 
+#if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+static CaptureReadback *RequestScreenCapture(CaptureQueue *queue, const char *fileName); // Request a readback of the next frame, sent to a queue once read
+static void StartScreenCaptures(void);          // Start requested readbacks (frame is complete, not swapped yet)
+static void FinishScreenCaptures(bool flush);   // Read completed readbacks and push them to their queues, waiting for every one if flush
+static void SubmitCaptureJob(CaptureQueue *queue, CaptureJob *job); // Push a captured frame to its queue, dropping it if the queue drops jobs and is full
+static void StartCaptureQueue(CaptureQueue *queue, void (*process)(CaptureJob *job), bool dropJobs); // Start a capture queue worker
+static bool PushCaptureJob(CaptureQueue *queue, CaptureJob *job, bool wait); // Push a job to a capture queue, false if full and not waiting
+static void StopCaptureQueue(CaptureQueue *queue); // Process remaining jobs and stop a capture queue worker
+static void FlipCapturePixels(CaptureJob *job); // Flip captured rows to top-down and make them opaque
+static void SaveScreenshotJob(CaptureJob *job); // Encode and save a screenshot (PNG or QOI)
+#if defined(SUPPORT_GIF_RECORDING)
+static void EncodeGifJob(CaptureJob *job);      // Add a frame to the GIF recording, or finish it
+#endif
+#endif
+
 #if defined(_WIN32) && !defined(PLATFORM_DESKTOP_RGFW)
 // NOTE: We declare Sleep() function symbol to avoid including windows.h (kernel32.lib linkage required)
 void __stdcall Sleep(unsigned long msTimeout);              // Required for: WaitTime()
@@ -506,6 +637,8 @@ const char *TextFormat(const char *text, ...);              // Formatting of tex
     #include "platforms/rcore_drm.c"
 #elif defined(PLATFORM_ANDROID)
     #include "platforms/rcore_android.c"
+#elif defined(PLATFORM_MEMORY)
+    #include "platforms/rcore_memory.c"
 #else
     // TODO: Include your custom platform backend!
     // i.e software rendering backend or console backend!
@@ -574,6 +707,8 @@ void InitWindow(int width, int height, const char *title)
     TRACELOG(LOG_INFO, "Platform backend: NATIVE DRM");
 #elif defined(PLATFORM_ANDROID)
     TRACELOG(LOG_INFO, "Platform backend: ANDROID");
+#elif defined(PLATFORM_MEMORY)
+    TRACELOG(LOG_INFO, "Platform backend: MEMORY (software renderer)");
 #else
     // TODO: Include your custom platform backend!
     // i.e software rendering backend or console backend!
@@ -685,12 +820,33 @@ void CloseWindow(void)
 #if defined(SUPPORT_GIF_RECORDING)
     if (gifRecording)
     {
+    #if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+        // Recording is discarded, the end job has no file name
+        FinishScreenCaptures(true);
+        CaptureJob job = { 0 };
+        PushCaptureJob(&gifQueue, &job, true);
+    #else
         MsfGifResult result = msf_gif_end(&gifState);
         msf_gif_free(result);
+    #endif
         gifRecording = false;
     }
 #endif
 
+#if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+    // Pending captures are read and saved before the context is gone
+    FinishScreenCaptures(true);
+    for (int i = 0; i < MAX_CAPTURE_READBACKS; i++)
+    {
+        if (captureReadbacks[i].pbo != 0) rlUnloadPixelBuffer(captureReadbacks[i].pbo);
+        captureReadbacks[i] = (CaptureReadback){ 0 };
+    }
+    StopCaptureQueue(&screenshotQueue);
+#if defined(SUPPORT_GIF_RECORDING)
+    StopCaptureQueue(&gifQueue);
+#endif
+#endif
+
 #if defined(SUPPORT_MODULE_RTEXT) && defined(SUPPORT_DEFAULT_FONT)
     UnloadFontDefault();        // WARNING: Module required: rtext
 #endif
@@ -837,6 +993,7 @@ void BeginDrawing(void)
     CORE.Time.update = CORE.Time.current - CORE.Time.previous;
     CORE.Time.previous = CORE.Time.current;
 
+    rlResetRenderStats();               // Render stats count this frame, read them after EndDrawing()
     rlLoadIdentity();                   // Reset current matrix (modelview)
     rlMultMatrixf(MatrixToFloat(CORE.Window.screenScale)); // Apply screen scaling
 
@@ -853,28 +1010,38 @@ void EndDrawing(void)
     // Draw record indicator
     if (gifRecording)
     {
-        #ifndef GIF_RECORD_FRAMERATE
-        #define GIF_RECORD_FRAMERATE    10
-        #endif
         gifFrameCounter += (unsigned int)(GetFrameTime()*1000);
 
         // NOTE: We record one gif frame depending on the desired gif framerate
         if (gifFrameCounter > 1000/GIF_RECORD_FRAMERATE)
         {
+        #if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+            // Frame is read back a few frames later and encoded on the GIF worker,
+            // dropped rather than stalling the game loop if the encoder can't keep up
+            CaptureReadback *readback = RequestScreenCapture(&gifQueue, "");
+
+            if (readback != NULL)
+            {
+                readback->delay = gifFrameCounter/10;
+                StartScreenCaptures();      // Start it now, before the recording indicator is drawn
+            }
+            else
+            {
+                gifQueue.droppedJobs++;
+                gifQueue.droppedDelay += gifFrameCounter/10;
+            }
+        #else
             // Get image data for the current frame (from backbuffer)
             // NOTE: This process is quite slow... :(
             Vector2 scale = GetWindowScaleDPI();
             unsigned char *screenData = rlReadScreenPixels((int)((float)CORE.Window.render.width*scale.x), (int)((float)CORE.Window.render.height*scale.y));
 
-            #ifndef GIF_RECORD_BITRATE
-            #define GIF_RECORD_BITRATE 16
-            #endif
-
             // Add the frame to the gif recording, given how many frames have passed in centiseconds
             msf_gif_frame(&gifState, screenData, gifFrameCounter/10, GIF_RECORD_BITRATE, (int)((float)CORE.Window.render.width*scale.x)*4);
-            gifFrameCounter -= 1000/GIF_RECORD_FRAMERATE;
 
             RL_FREE(screenData);    // Free image data
+        #endif
+            gifFrameCounter -= 1000/GIF_RECORD_FRAMERATE;
         }
 
     #if defined(SUPPORT_MODULE_RSHAPES) && defined(SUPPORT_MODULE_RTEXT)
@@ -894,6 +1061,11 @@ void EndDrawing(void)
     if (automationEventRecording) RecordAutomationEvent();    // Event recording
 #endif
 
+#if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+    StartScreenCaptures();      // Queue readbacks of the frame, before it is swapped
+    FinishScreenCaptures(false);
+#endif
+
 #if !defined(SUPPORT_CUSTOM_FRAME_CONTROL)
     SwapScreenBuffer();                  // Copy back buffer to front buffer (screen)
 
@@ -905,9 +1077,15 @@ void EndDrawing(void)
     CORE.Time.frame = CORE.Time.update + CORE.Time.draw;
 
     // Wait for some milliseconds...
+#if defined(PRECISE_FRAME_PACING)
+    if (CORE.Time.target > 0.0)
+    {
+        WaitFrameDeadline();
+#else
     if (CORE.Time.frame < CORE.Time.target)
     {
         WaitTime(CORE.Time.target - CORE.Time.frame);
+#endif
 
         CORE.Time.current = GetTime();
         double waitTime = CORE.Time.current - CORE.Time.previous;
@@ -916,6 +1094,10 @@ void EndDrawing(void)
         CORE.Time.frame += waitTime;    // Total frame time: update + draw + wait
     }
 
+    frameTimes[frameTimesNext] = (float)CORE.Time.frame;
+    frameTimesNext = (frameTimesNext + 1)%MAX_FRAME_TIME_SAMPLES;
+    if (frameTimesCount < MAX_FRAME_TIME_SAMPLES) frameTimesCount++;
+
     PollInputEvents();      // Poll user events (before next frame update)
 #endif
 
@@ -929,20 +1111,38 @@ void EndDrawing(void)
             {
                 gifRecording = false;
 
+            #if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+                // Frames in flight are pushed first, the worker saves the file once it reaches the end job
+                FinishScreenCaptures(true);
+
+                CaptureJob job = { 0 };
+                strcpy(job.fileName, TextFormat("%s/screenrec%03i.gif", CORE.Storage.basePath, screenshotCounter));
+                PushCaptureJob(&gifQueue, &job, true);
+
+                if (gifQueue.droppedJobs > 0) TRACELOG(LOG_WARNING, "SYSTEM: %i GIF frames dropped, encoder could not keep up", gifQueue.droppedJobs);
+            #else
                 MsfGifResult result = msf_gif_end(&gifState);
 
                 SaveFileData(TextFormat("%s/screenrec%03i.gif", CORE.Storage.basePath, screenshotCounter), result.data, (unsigned int)result.dataSize);
                 msf_gif_free(result);
 
                 TRACELOG(LOG_INFO, "SYSTEM: Finish animated GIF recording");
+            #endif
             }
             else
             {
                 gifRecording = true;
                 gifFrameCounter = 0;
 
+            #if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+                // Recording begins on the worker with the first captured frame
+                if (!gifQueue.running) StartCaptureQueue(&gifQueue, EncodeGifJob, true);
+                gifQueue.droppedJobs = 0;
+                gifQueue.droppedDelay = 0;
+            #else
                 Vector2 scale = GetWindowScaleDPI();
                 msf_gif_begin(&gifState, (int)((float)CORE.Window.render.width*scale.x), (int)((float)CORE.Window.render.height*scale.y));
+            #endif
                 screenshotCounter++;
 
                 TRACELOG(LOG_INFO, "SYSTEM: Start animated GIF recording: %s", TextFormat("screenrec%03i.gif", screenshotCounter));
@@ -951,7 +1151,11 @@ void EndDrawing(void)
         else
 #endif  // SUPPORT_GIF_RECORDING
         {
+        #if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+            TakeScreenshotAsync(TextFormat("screenshot%03i.png", screenshotCounter));
+        #else
             TakeScreenshot(TextFormat("screenshot%03i.png", screenshotCounter));
+        #endif
             screenshotCounter++;
         }
     }
@@ -1655,6 +1859,23 @@ float GetFrameTime(void)
     return (float)CORE.Time.frame;
 }
 
+// Get standard deviation of recent frame times in seconds
+// NOTE: Measures frame pacing, with a target FPS set it should stay well under a millisecond
+float GetFrameTimeJitter(void)
+{
+    if (frameTimesCount < 2) return 0.0f;
+
+    float average = 0.0f;
+    for (int i = 0; i < frameTimesCount; i++) average += frameTimes[i];
+    average /= frameTimesCount;
+
+    float variance = 0.0f;
+    for (int i = 0; i < frameTimesCount; i++) variance += (frameTimes[i] - average)*(frameTimes[i] - average);
+    variance /= (frameTimesCount - 1);
+
+    return sqrtf(variance);
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition: Custom frame control
 //----------------------------------------------------------------------------------
@@ -1672,6 +1893,11 @@ void WaitTime(double seconds)
 {
     if (seconds < 0) return;    // Security check
 
+#if defined(PRECISE_FRAME_PACING)
+    WaitUntilDeadline(GetMonotonicTime() + (unsigned long long)(seconds*1e9));
+    return;
+#endif
+
 #if defined(SUPPORT_BUSY_WAIT_LOOP) || defined(SUPPORT_PARTIALBUSY_WAIT_LOOP)
     double destinationTime = GetTime() + seconds;
 #endif
@@ -1829,6 +2055,35 @@ void TakeScreenshot(const char *fileName)
 #endif
 }
 
+// Takes a screenshot of the next frame, without stalling it
+// NOTE: Frame is read back a few frames later, encoded and saved on a worker thread, only PNG and QOI are supported
+void TakeScreenshotAsync(const char *fileName)
+{
+#if defined(SUPPORT_ASYNC_SCREEN_CAPTURE) && defined(SUPPORT_MODULE_RTEXTURES)
+    // Security check to (partially) avoid malicious code
+    if (strchr(fileName, '\'') != NULL) { TRACELOG(LOG_WARNING, "SYSTEM: Provided fileName could be potentially malicious, avoid [\'] character"); return; }
+
+    if (!IsFileExtension(fileName, ".png;.qoi"))
+    {
+        TRACELOG(LOG_WARNING, "SYSTEM: [%s] Asynchronous screenshots only support PNG and QOI, taking it synchronously", fileName);
+        TakeScreenshot(fileName);
+        return;
+    }
+
+    char path[512] = { 0 };
+    strcpy(path, TextFormat("%s/%s", CORE.Storage.basePath, GetFileName(fileName)));
+
+    if (!screenshotQueue.running) StartCaptureQueue(&screenshotQueue, SaveScreenshotJob, false);
+    if (RequestScreenCapture(&screenshotQueue, path) == NULL)
+    {
+        TRACELOG(LOG_WARNING, "SYSTEM: [%s] Too many screen captures in flight, taking screenshot synchronously", path);
+        TakeScreenshot(fileName);
+    }
+#else
+    TakeScreenshot(fileName);
+#endif
+}
+
 // Setup window configuration flags (view FLAGS)
 // NOTE: This function is expected to be called before window creation,
 // because it sets up some flags for the window creation process
@@ -3169,6 +3424,373 @@ void InitTimer(void)
     CORE.Time.previous = GetTime();     // Get time as double
 }
 
+#if defined(PRECISE_FRAME_PACING)
+// Get CLOCK_MONOTONIC time in nanoseconds, the clock deadlines are measured on
+static unsigned long long GetMonotonicTime(void)
+{
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (unsigned long long)now.tv_sec*1000000000LLU + (unsigned long long)now.tv_nsec;
+}
+
+// Sleep until a CLOCK_MONOTONIC deadline
+// NOTE: The thread wakes up framePacing.slack early and spins the rest, slack follows the oversleep measured
+// on every wake up: it grows at once when the scheduler is late and decays slowly when it is on time
+static void WaitUntilDeadline(unsigned long long deadline)
+{
+    unsigned long long now = GetMonotonicTime();
+    if (now >= deadline) return;
+
+    if (deadline - now > (unsigned long long)framePacing.slack)
+    {
+        unsigned long long wakeUp = deadline - framePacing.slack;
+        struct timespec req = { (time_t)(wakeUp/1000000000LLU), (long)(wakeUp%1000000000LLU) };
+
+        // Absolute deadline, a signal only interrupts the sleep and it is restarted with the same deadline
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &req, NULL) == EINTR) { }
+
+        long long oversleep = (long long)(GetMonotonicTime() - wakeUp);
+
+        if (oversleep > framePacing.slack) framePacing.slack = oversleep;
+        else framePacing.slack -= (framePacing.slack - oversleep)/16;
+
+        if (framePacing.slack < 0) framePacing.slack = 0;
+        else if (framePacing.slack > FRAME_PACING_MAX_SLACK) framePacing.slack = FRAME_PACING_MAX_SLACK;
+    }
+
+    while (GetMonotonicTime() < deadline) { }
+}
+
+// Wait for the end of the current frame
+// NOTE: Deadlines are one frame period apart so sleep error does not add up from frame to frame,
+// the schedule restarts from now when the target FPS changes or a frame is late by a whole period
+static void WaitFrameDeadline(void)
+{
+    unsigned long long now = GetMonotonicTime();
+    unsigned long long period = (unsigned long long)(CORE.Time.target*1e9);
+
+    if ((framePacing.deadline != 0) && (framePacing.period == period) && (now < framePacing.deadline + period)) framePacing.deadline += period;
+    else
+    {
+        double remaining = CORE.Time.target - CORE.Time.frame;
+        framePacing.deadline = now + ((remaining > 0.0)? (unsigned long long)(remaining*1e9) : 0);
+        framePacing.period = period;
+    }
+
+    WaitUntilDeadline(framePacing.deadline);
+}
+#endif
+
+#if defined(SUPPORT_ASYNC_SCREEN_CAPTURE)
+// Request a readback of the next frame, the captured frame is pushed to the queue once read
+static CaptureReadback *RequestScreenCapture(CaptureQueue *queue, const char *fileName)
+{
+    for (int i = 0; i < MAX_CAPTURE_READBACKS; i++)
+    {
+        CaptureReadback *readback = &captureReadbacks[i];
+
+        if (!readback->requested && !readback->pending)
+        {
+            readback->requested = true;
+            readback->queue = queue;
+            readback->delay = 0;
+            snprintf(readback->fileName, sizeof(readback->fileName), "%s", fileName);
+
+            return readback;
+        }
+    }
+
+    return NULL;
+}
+
+// Start requested readbacks, the frame is complete but not swapped yet
+static void StartScreenCaptures(void)
+{
+    for (int i = 0; i < MAX_CAPTURE_READBACKS; i++)
+    {
+        CaptureReadback *readback = &captureReadbacks[i];
+        if (!readback->requested) continue;
+
+        Vector2 scale = GetWindowScaleDPI();
+        int width = (int)((float)CORE.Window.render.width*scale.x);
+        int height = (int)((float)CORE.Window.render.height*scale.y);
+
+        readback->requested = false;
+        readback->width = width;
+        readback->height = height;
+        readback->frame = CORE.Time.frameCounter;
+
+        // Pixel buffers are kept between captures, only reloaded when the screen size changes
+        if (readback->size != width*height*4)
+        {
+            if (readback->pbo != 0) rlUnloadPixelBuffer(readback->pbo);
+            readback->pbo = rlLoadPixelBuffer(width*height*4);
+            readback->size = width*height*4;
+        }
+
+        if (readback->pbo != 0)
+        {
+            rlReadScreenPixelsToBuffer(readback->pbo, width, height);
+            readback->pending = true;
+        }
+        else
+        {
+            // No pixel buffers, read synchronously but still encode on the worker
+            CaptureJob job = { rlReadScreenPixels(width, height), width, height, false, readback->delay };
+            strcpy(job.fileName, readback->fileName);
+            SubmitCaptureJob(readback->queue, &job);
+        }
+    }
+}
+
+// Read completed readbacks and push them to their queues
+// NOTE: With flush, every pending readback is read, waiting for the GPU if required
+static void FinishScreenCaptures(bool flush)
+{
+    for (int i = 0; i < MAX_CAPTURE_READBACKS; i++)
+    {
+        CaptureReadback *readback = &captureReadbacks[i];
+        if (!readback->pending) continue;
+        if (!flush && ((CORE.Time.frameCounter - readback->frame) < CAPTURE_READBACK_DELAY)) continue;
+
+        readback->pending = false;
+
+        CaptureJob job = { (unsigned char *)RL_MALLOC(readback->size), readback->width, readback->height, true, readback->delay };
+        strcpy(job.fileName, readback->fileName);
+
+        if (rlReadPixelBuffer(readback->pbo, job.pixels, readback->size)) SubmitCaptureJob(readback->queue, &job);
+        else
+        {
+            TRACELOG(LOG_WARNING, "SYSTEM: [%s] Failed to read screen capture", job.fileName);
+            RL_FREE(job.pixels);
+        }
+    }
+}
+
+// Push a captured frame to its queue, the queue owns the pixels afterwards
+// NOTE: Queues dropping jobs never stall the frame, a dropped frame's duration is added to the next pushed one
+static void SubmitCaptureJob(CaptureQueue *queue, CaptureJob *job)
+{
+    job->delay += queue->droppedDelay;
+
+    if (PushCaptureJob(queue, job, !queue->dropJobs)) queue->droppedDelay = 0;
+    else
+    {
+        if (queue->dropJobs)
+        {
+            queue->droppedJobs++;
+            queue->droppedDelay = job->delay;
+        }
+        else TRACELOG(LOG_WARNING, "SYSTEM: [%s] Failed to process screen capture", job->fileName);
+
+        RL_FREE(job->pixels);
+    }
+}
+
+#if defined(CAPTURE_WORKER_THREADS)
+// Capture queue worker thread, processes jobs in order until the queue stops
+static void *CaptureQueueWorker(void *arg)
+{
+    CaptureQueue *queue = (CaptureQueue *)arg;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (true)
+    {
+        while ((queue->count == 0) && !queue->stopping) pthread_cond_wait(&queue->changed, &queue->mutex);
+        if (queue->count == 0) break;   // Stopping and nothing left to process
+
+        CaptureJob job = queue->jobs[queue->first];
+        queue->first = (queue->first + 1)%MAX_CAPTURE_QUEUE_JOBS;
+        queue->count--;
+        pthread_cond_broadcast(&queue->changed);    // Wake up a producer waiting for room
+
+        pthread_mutex_unlock(&queue->mutex);
+        queue->process(&job);
+        pthread_mutex_lock(&queue->mutex);
+    }
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return NULL;
+}
+#endif
+
+// Start a capture queue worker
+// NOTE: If threads are not available, jobs are processed when pushed
+static void StartCaptureQueue(CaptureQueue *queue, void (*process)(CaptureJob *job), bool dropJobs)
+{
+    queue->first = 0;
+    queue->count = 0;
+    queue->process = process;
+    queue->stopping = false;
+    queue->dropJobs = dropJobs;
+    queue->droppedJobs = 0;
+    queue->droppedDelay = 0;
+
+#if defined(CAPTURE_WORKER_THREADS)
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->changed, NULL);
+
+    if (pthread_create(&queue->thread, NULL, CaptureQueueWorker, queue) == 0) queue->running = true;
+    else
+    {
+        TRACELOG(LOG_WARNING, "SYSTEM: Failed to start capture worker thread, captures are encoded on the main thread");
+        pthread_cond_destroy(&queue->changed);
+        pthread_mutex_destroy(&queue->mutex);
+    }
+#endif
+}
+
+// Push a job to a capture queue, the queue owns the job pixels on success
+// NOTE: When the queue is full, waits for room if requested, otherwise the job is dropped
+static bool PushCaptureJob(CaptureQueue *queue, CaptureJob *job, bool wait)
+{
+    bool pushed = false;
+
+#if defined(CAPTURE_WORKER_THREADS)
+    if (queue->running)
+    {
+        pthread_mutex_lock(&queue->mutex);
+
+        while (wait && (queue->count == MAX_CAPTURE_QUEUE_JOBS)) pthread_cond_wait(&queue->changed, &queue->mutex);
+
+        if (queue->count < MAX_CAPTURE_QUEUE_JOBS)
+        {
+            queue->jobs[(queue->first + queue->count)%MAX_CAPTURE_QUEUE_JOBS] = *job;
+            queue->count++;
+            pushed = true;
+            pthread_cond_broadcast(&queue->changed);
+        }
+
+        pthread_mutex_unlock(&queue->mutex);
+
+        return pushed;
+    }
+#endif
+
+    if (queue->process != NULL)
+    {
+        queue->process(job);
+        pushed = true;
+    }
+
+    return pushed;
+}
+
+// Process remaining jobs and stop a capture queue worker
+static void StopCaptureQueue(CaptureQueue *queue)
+{
+#if defined(CAPTURE_WORKER_THREADS)
+    if (queue->running)
+    {
+        pthread_mutex_lock(&queue->mutex);
+        queue->stopping = true;
+        pthread_cond_broadcast(&queue->changed);
+        pthread_mutex_unlock(&queue->mutex);
+
+        pthread_join(queue->thread, NULL);
+        pthread_cond_destroy(&queue->changed);
+        pthread_mutex_destroy(&queue->mutex);
+    }
+#endif
+
+    queue->running = false;
+    queue->process = NULL;
+}
+
+// Flip captured rows to top-down and make them opaque
+// NOTE: Alpha value has already been applied to RGB in framebuffer, we don't need it!
+static void FlipCapturePixels(CaptureJob *job)
+{
+    int stride = job->width*4;
+
+    for (int y = 0; y < job->height; y++)
+    {
+        unsigned char *row = job->pixels + y*stride;
+        for (int x = 3; x < stride; x += 4) row[x] = 255;
+    }
+
+    if (!job->bottomUp) return;
+
+    unsigned char *line = (unsigned char *)RL_MALLOC(stride);
+
+    for (int y = 0; y < job->height/2; y++)
+    {
+        unsigned char *top = job->pixels + y*stride;
+        unsigned char *bottom = job->pixels + (job->height - 1 - y)*stride;
+        memcpy(line, top, stride);
+        memcpy(top, bottom, stride);
+        memcpy(bottom, line, stride);
+    }
+
+    RL_FREE(line);
+    job->bottomUp = false;
+}
+
+// Encode and save a screenshot, runs on the worker thread
+// NOTE: Only thread-safe functions can be used here: no TextFormat(), no IsFileExtension()
+static void SaveScreenshotJob(CaptureJob *job)
+{
+#if defined(SUPPORT_MODULE_RTEXTURES)
+    FlipCapturePixels(job);
+
+    Image image = { job->pixels, job->width, job->height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    const char *fileType = strrchr(job->fileName, '.');
+
+    int dataSize = 0;
+    unsigned char *fileData = ExportImageToMemory(image, (fileType != NULL)? fileType : "", &dataSize);   // WARNING: Module required: rtextures
+
+    if ((fileData != NULL) && SaveFileData(job->fileName, fileData, dataSize)) TRACELOG(LOG_INFO, "SYSTEM: [%s] Screenshot taken successfully", job->fileName);
+    else TRACELOG(LOG_WARNING, "SYSTEM: [%s] Screenshot could not be saved", job->fileName);
+
+    RL_FREE(fileData);
+#endif
+    RL_FREE(job->pixels);
+}
+
+#if defined(SUPPORT_GIF_RECORDING)
+// Add a frame to the GIF recording, runs on the GIF worker thread
+// NOTE: A job without pixels finishes the recording, saved if it has a file name,
+// gifState is only used by the worker while the queue is running
+static void EncodeGifJob(CaptureJob *job)
+{
+    if (job->pixels == NULL)
+    {
+        if (gifEncoding)
+        {
+            MsfGifResult result = msf_gif_end(&gifState);
+
+            if (job->fileName[0] != '\0')
+            {
+                if (SaveFileData(job->fileName, result.data, (unsigned int)result.dataSize)) TRACELOG(LOG_INFO, "SYSTEM: [%s] Finish animated GIF recording", job->fileName);
+                else TRACELOG(LOG_WARNING, "SYSTEM: [%s] Animated GIF recording could not be saved", job->fileName);
+            }
+
+            msf_gif_free(result);
+            gifEncoding = false;
+        }
+
+        return;
+    }
+
+    // Recording begins with the first frame, so its size is the one actually captured
+    if (!gifEncoding) gifEncoding = msf_gif_begin(&gifState, job->width, job->height);
+
+    // NOTE: Frames captured after a window resize are skipped, GIF frames share the recording size
+    if (gifEncoding && (job->width == gifState.width) && (job->height == gifState.height))
+    {
+        // Bottom-up rows are handled by the encoder with a negative pitch, no flip required
+        int pitch = job->bottomUp? -job->width*4 : job->width*4;
+        msf_gif_frame(&gifState, job->pixels, job->delay, GIF_RECORD_BITRATE, pitch);
+    }
+
+    RL_FREE(job->pixels);
+}
+#endif
+#endif  // SUPPORT_ASYNC_SCREEN_CAPTURE
+
 // Set viewport for a provided width and height
 void SetupViewport(int width, int height)
 {
@@ -31,6 +31,10 @@
 *           Those preprocessor defines are only used on rlgl module, if OpenGL version is
 *           required by any other module, use rlGetVersion() to check it
 *
+*       #define GRAPHICS_API_OPENGL_11_SOFTWARE
+*           Use the OpenGL 1.1 backend on top of rlsw, a CPU rasterizer drawing into memory,
+*           no GPU or windowing system required (see external/rlsw.h for limitations)
+*
 *       #define RLGL_IMPLEMENTATION
 *           Generates the implementation of the library into the included file.
 *           If not defined, the library is in header only mode and can be included in other headers
@@ -145,6 +149,11 @@
     #define RL_FREE(p)        free(p)
 #endif
 
+// Software renderer implements the OpenGL 1.1 API
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    #define GRAPHICS_API_OPENGL_11
+#endif
+
 // Security check in case no GRAPHICS_API_OPENGL_* defined
 #if !defined(GRAPHICS_API_OPENGL_11) && \
     !defined(GRAPHICS_API_OPENGL_21) && \
@@ -210,7 +219,7 @@
     #endif
 #endif
 #ifndef RL_DEFAULT_BATCH_BUFFERS
-    #define RL_DEFAULT_BATCH_BUFFERS                 1      // Default number of batch buffers (multi-buffering)
+    #define RL_DEFAULT_BATCH_BUFFERS                 3      // Default number of batch buffers (multi-buffering)
 #endif
 #ifndef RL_DEFAULT_BATCH_DRAWCALLS
     #define RL_DEFAULT_BATCH_DRAWCALLS             256      // Default number of batch draw calls (by state changes: mode, texture)
@@ -379,6 +388,10 @@ typedef struct rlVertexBuffer {
 #endif
     unsigned int vaoId;         // OpenGL Vertex Array Object id
     unsigned int vboId[5];      // OpenGL Vertex Buffer Objects id (5 types of vertex data)
+#if defined(GRAPHICS_API_OPENGL_33)
+    bool mapped[4];             // Vertex data arrays point to persistently mapped VBO memory (GL_ARB_buffer_storage)
+    void *fence;                // Sync object of the last draw using mapped arrays (GLsync)
+#endif
 } rlVertexBuffer;
 
 // Draw call type
@@ -408,6 +421,18 @@ typedef struct rlRenderBatch {
     float currentDepth;         // Current depth value for next draw
 } rlRenderBatch;
 
+// rlRenderStats type
+// NOTE: Accumulated since last rlResetRenderStats(), reset by BeginDrawing() so a frame is complete after EndDrawing()
+typedef struct rlRenderStats {
+    int drawCalls;              // Draw calls submitted (batch draws and vertex array draws)
+    int vertices;               // Vertices submitted by those draw calls
+    int flushes;                // Render batch draws with vertex data
+    int overflowFlushes;        // Render batch draws forced by the batch limits (rlCheckRenderBatchLimit())
+    int textureBinds;           // Texture changes between batch draw calls
+    int stateChanges;           // Shader, blend mode and framebuffer changes
+    int bytesUploaded;          // Vertex, texture and buffer data updated on GPU
+} rlRenderStats;
+
 // OpenGL version
 typedef enum {
     RL_OPENGL_11 = 1,           // OpenGL 1.1
@@ -607,6 +632,7 @@ RLAPI void rlNormal3f(float x, float y, float z);       // Define one vertex (no
 RLAPI void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a); // Define one vertex (color) - 4 byte
 RLAPI void rlColor3f(float x, float y, float z);        // Define one vertex (color) - 3 float
 RLAPI void rlColor4f(float x, float y, float z, float w); // Define one vertex (color) - 4 float
+RLAPI void rlRectangle2f(float x, float y, float width, float height, float s0, float t0, float s1, float t1); // Define one axis-aligned quad (4 vertex) - RL_QUADS only
 
 //------------------------------------------------------------------------------------
 // Functions Declaration - OpenGL style functions (common to 1.1, 3.3+, ES2)
@@ -707,6 +733,8 @@ RLAPI void rlDrawRenderBatch(rlRenderBatch *batch);     // Draw render batch dat
 RLAPI void rlSetRenderBatchActive(rlRenderBatch *batch); // Set the active render batch for rlgl (NULL for default internal)
 RLAPI void rlDrawRenderBatchActive(void);               // Update and draw internal render batch
 RLAPI bool rlCheckRenderBatchLimit(int vCount);         // Check internal buffer overflow for a given number of vertex
+RLAPI rlRenderStats rlGetRenderStats(void);             // Get render statistics accumulated since last reset
+RLAPI void rlResetRenderStats(void);                    // Reset render statistics
 
 RLAPI void rlSetTexture(unsigned int id);               // Set current texture for render batch and check buffers limits
 
@@ -740,6 +768,12 @@ RLAPI void rlGenTextureMipmaps(unsigned int id, int width, int height, int forma
 RLAPI void *rlReadTexturePixels(unsigned int id, int width, int height, int format); // Read texture pixel data
 RLAPI unsigned char *rlReadScreenPixels(int width, int height);           // Read screen pixel data (color buffer)
 
+// Pixel buffers management (asynchronous readback)
+RLAPI unsigned int rlLoadPixelBuffer(int size);                           // Load a pixel pack buffer, returns 0 if not supported
+RLAPI void rlUnloadPixelBuffer(unsigned int id);                          // Unload pixel pack buffer
+RLAPI void rlReadScreenPixelsToBuffer(unsigned int id, int width, int height); // Start copying screen pixels into a pixel buffer, does not wait for the GPU
+RLAPI bool rlReadPixelBuffer(unsigned int id, unsigned char *data, int size); // Get pixel buffer data (RGBA, rows bottom-up), waits if the copy is not finished
+
 // Framebuffer management (fbo)
 RLAPI unsigned int rlLoadFramebuffer(void);                               // Load an empty framebuffer
 RLAPI void rlFramebufferAttach(unsigned int fboId, unsigned int texId, int attachType, int texType, int mipLevel); // Attach texture/renderbuffer to a framebuffer
@@ -809,7 +843,67 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
     #define GLAD_API_CALL_EXPORT_BUILD
 #endif
 
-#if defined(GRAPHICS_API_OPENGL_11)
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    #define RLSW_IMPLEMENTATION
+    #include "external/rlsw.h"          // OpenGL 1.1 software rasterizer, defines OpenGL types and enums
+
+    #define glEnable                swEnable
+    #define glDisable               swDisable
+    #define glHint                  swHint
+    #define glShadeModel            swShadeModel
+    #define glPixelStorei           swPixelStorei
+    #define glPolygonMode           swPolygonMode
+    #define glLineWidth             swLineWidth
+    #define glCullFace              swCullFace
+    #define glFrontFace             swFrontFace
+    #define glDepthFunc             swDepthFunc
+    #define glDepthMask             swDepthMask
+    #define glColorMask             swColorMask
+    #define glBlendFunc             swBlendFunc
+    #define glScissor               swScissor
+    #define glViewport              swViewport
+    #define glClearColor            swClearColor
+    #define glClearDepth            swClearDepth
+    #define glClear                 swClear
+    #define glGetFloatv             swGetFloatv
+    #define glGetString             swGetString
+    #define glMatrixMode            swMatrixMode
+    #define glPushMatrix            swPushMatrix
+    #define glPopMatrix             swPopMatrix
+    #define glLoadIdentity          swLoadIdentity
+    #define glMultMatrixf           swMultMatrixf
+    #define glTranslatef            swTranslatef
+    #define glRotatef               swRotatef
+    #define glScalef                swScalef
+    #define glOrtho                 swOrtho
+    #define glFrustum               swFrustum
+    #define glBegin                 swBegin
+    #define glEnd                   swEnd
+    #define glVertex2i              swVertex2i
+    #define glVertex2f              swVertex2f
+    #define glVertex3f              swVertex3f
+    #define glTexCoord2f            swTexCoord2f
+    #define glNormal3f              swNormal3f
+    #define glColor4ub              swColor4ub
+    #define glColor3f               swColor3f
+    #define glColor4f               swColor4f
+    #define glEnableClientState     swEnableClientState
+    #define glDisableClientState    swDisableClientState
+    #define glVertexPointer         swVertexPointer
+    #define glTexCoordPointer       swTexCoordPointer
+    #define glColorPointer          swColorPointer
+    #define glNormalPointer         swNormalPointer
+    #define glDrawArrays            swDrawArrays
+    #define glDrawElements          swDrawElements
+    #define glGenTextures           swGenTextures
+    #define glDeleteTextures        swDeleteTextures
+    #define glBindTexture           swBindTexture
+    #define glTexImage2D            swTexImage2D
+    #define glTexSubImage2D         swTexSubImage2D
+    #define glTexParameteri         swTexParameteri
+    #define glGetTexImage           swGetTexImage
+    #define glReadPixels            swReadPixels
+#elif defined(GRAPHICS_API_OPENGL_11)
     #if defined(__APPLE__)
         #include <OpenGL/gl.h>          // OpenGL 1.1 library for OSX
         #include <OpenGL/glext.h>       // OpenGL extensions library
@@ -866,7 +960,7 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
 #endif
 
 #include <stdlib.h>                     // Required for: malloc(), free()
-#include <string.h>                     // Required for: strcmp(), strlen() [Used in rlglInit(), on extensions loading]
+#include <string.h>                     // Required for: strcmp(), strlen() [Used in rlglInit(), on extensions loading], memcpy()
 #include <math.h>                       // Required for: sqrtf(), sinf(), cosf(), floor(), log()
 
 //----------------------------------------------------------------------------------
@@ -1072,6 +1166,7 @@ typedef struct rlglData {
         bool texAnisoFilter;                // Anisotropic texture filtering support (GL_EXT_texture_filter_anisotropic)
         bool computeShader;                 // Compute shaders support (GL_ARB_compute_shader)
         bool ssbo;                          // Shader storage buffer object support (GL_ARB_shader_storage_buffer_object)
+        bool bufferStorage;                 // Persistently mapped buffers support (GL_ARB_buffer_storage)
 
         float maxAnisotropyLevel;           // Maximum anisotropy level supported (minimum is 2.0f)
         int maxDepthBits;                   // Maximum bits for depth component
@@ -1088,6 +1183,7 @@ typedef void *(*rlglLoadProc)(const char *name);   // OpenGL extension functions
 //----------------------------------------------------------------------------------
 static double rlCullDistanceNear = RL_CULL_DISTANCE_NEAR;
 static double rlCullDistanceFar = RL_CULL_DISTANCE_FAR;
+static rlRenderStats rlStats = { 0 };
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static rlglData RLGL = { 0 };
@@ -1111,6 +1207,8 @@ static PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisor = NULL;
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static void rlLoadShaderDefault(void);      // Load default shader
 static void rlUnloadShaderDefault(void);    // Unload default shader
+static void *rlLoadBatchStream(rlVertexBuffer *buffer, int stream, void *data, int size); // Load a batch vertex stream VBO, returns the array to write vertex data into
+static void rlUpdateBatchStream(rlVertexBuffer *buffer, int stream, int shaderLoc, const void *data, int size, int capacity); // Upload a batch vertex stream for drawing, if required
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 static const char *rlGetCompressedFormatName(int format); // Get compressed format official GL identifier name
 #endif  // RLGL_SHOW_GL_DETAILS_INFO
@@ -1397,6 +1495,8 @@ double rlGetCullDistanceFar(void)
 //---------------------------------------
 void rlBegin(int mode)
 {
+    rlStats.drawCalls++;
+
     switch (mode)
     {
         case RL_LINES: glBegin(GL_LINES); break;
@@ -1407,14 +1507,22 @@ void rlBegin(int mode)
 }
 
 void rlEnd(void) { glEnd(); }
-void rlVertex2i(int x, int y) { glVertex2i(x, y); }
-void rlVertex2f(float x, float y) { glVertex2f(x, y); }
-void rlVertex3f(float x, float y, float z) { glVertex3f(x, y, z); }
+void rlVertex2i(int x, int y) { glVertex2i(x, y); rlStats.vertices++; }
+void rlVertex2f(float x, float y) { glVertex2f(x, y); rlStats.vertices++; }
+void rlVertex3f(float x, float y, float z) { glVertex3f(x, y, z); rlStats.vertices++; }
 void rlTexCoord2f(float x, float y) { glTexCoord2f(x, y); }
 void rlNormal3f(float x, float y, float z) { glNormal3f(x, y, z); }
 void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a) { glColor4ub(r, g, b, a); }
 void rlColor3f(float x, float y, float z) { glColor3f(x, y, z); }
 void rlColor4f(float x, float y, float z, float w) { glColor4f(x, y, z, w); }
+void rlRectangle2f(float x, float y, float width, float height, float s0, float t0, float s1, float t1)
+{
+    glTexCoord2f(s0, t0); glVertex2f(x, y);
+    glTexCoord2f(s0, t1); glVertex2f(x, y + height);
+    glTexCoord2f(s1, t1); glVertex2f(x + width, y + height);
+    glTexCoord2f(s1, t0); glVertex2f(x + width, y);
+    rlStats.vertices += 4;
+}
 #endif
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 // Initialize drawing mode (how to organize vertex)
@@ -1442,7 +1550,11 @@ void rlBegin(int mode)
             }
         }
 
-        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+        {
+            rlStats.overflowFlushes++;
+            rlDrawRenderBatch(RLGL.currentBatch);
+        }
 
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode = mode;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
@@ -1591,6 +1703,57 @@ void rlColor3f(float x, float y, float z)
     rlColor4ub((unsigned char)(x*255), (unsigned char)(y*255), (unsigned char)(z*255), 255);
 }
 
+// Define one axis-aligned quad (4 vertex), counter-clockwise from top-left, with current color and normal
+// NOTE: Must be called between rlBegin(RL_QUADS) and rlEnd(), vertex are written straight into
+// the current batch with a single limit check for the whole quad, instead of one per rlVertex3f()
+void rlRectangle2f(float x, float y, float width, float height, float s0, float t0, float s1, float t1)
+{
+    // A transformed quad is not axis-aligned anymore, go through the per-vertex path
+    if (RLGL.State.transformRequired)
+    {
+        rlTexCoord2f(s0, t0); rlVertex2f(x, y);
+        rlTexCoord2f(s0, t1); rlVertex2f(x, y + height);
+        rlTexCoord2f(s1, t1); rlVertex2f(x + width, y + height);
+        rlTexCoord2f(s1, t0); rlVertex2f(x + width, y);
+        return;
+    }
+
+    // NOTE: Batch could be drawn here, buffer, counter and depth must be read after the check
+    rlCheckRenderBatchLimit(4);
+
+    rlVertexBuffer *buffer = &RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer];
+    int first = RLGL.State.vertexCounter;
+    float z = RLGL.currentBatch->currentDepth;
+
+    const float positions[4][2] = { { x, y }, { x, y + height }, { x + width, y + height }, { x + width, y } };
+    const float texcoords[4][2] = { { s0, t0 }, { s0, t1 }, { s1, t1 }, { s1, t0 } };
+
+    for (int i = 0; i < 4; i++)
+    {
+        float *vertex = &buffer->vertices[3*(first + i)];
+        vertex[0] = positions[i][0];
+        vertex[1] = positions[i][1];
+        vertex[2] = z;
+
+        buffer->texcoords[2*(first + i)] = texcoords[i][0];
+        buffer->texcoords[2*(first + i) + 1] = texcoords[i][1];
+
+        float *normal = &buffer->normals[3*(first + i)];
+        normal[0] = RLGL.State.normalx;
+        normal[1] = RLGL.State.normaly;
+        normal[2] = RLGL.State.normalz;
+
+        unsigned char *color = &buffer->colors[4*(first + i)];
+        color[0] = RLGL.State.colorr;
+        color[1] = RLGL.State.colorg;
+        color[2] = RLGL.State.colorb;
+        color[3] = RLGL.State.colora;
+    }
+
+    RLGL.State.vertexCounter += 4;
+    RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount += 4;
+}
+
 #endif
 
 //--------------------------------------------------------------------------------------
@@ -1639,7 +1802,11 @@ void rlSetTexture(unsigned int id)
                 }
             }
 
-            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+            {
+                rlStats.overflowFlushes++;
+                rlDrawRenderBatch(RLGL.currentBatch);
+            }
 
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = id;
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
@@ -1803,6 +1970,7 @@ void rlEnableFramebuffer(unsigned int id)
 {
 #if (defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)) && defined(RLGL_RENDER_TEXTURES_HINT)
     glBindFramebuffer(GL_FRAMEBUFFER, id);
+    rlStats.stateChanges++;
 #endif
 }
 
@@ -1821,6 +1989,7 @@ void rlDisableFramebuffer(void)
 {
 #if (defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)) && defined(RLGL_RENDER_TEXTURES_HINT)
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    rlStats.stateChanges++;
 #endif
 }
 
@@ -2095,6 +2264,7 @@ void rlSetBlendMode(int mode)
 
         RLGL.State.currentBlendMode = mode;
         RLGL.State.glCustomBlendModeModified = false;
+        rlStats.stateChanges++;
     }
 #endif
 }
@@ -2206,6 +2376,12 @@ static void GLAPIENTRY rlDebugMessageCallback(GLenum source, GLenum type, GLuint
 // Initialize rlgl: OpenGL extensions, default buffers/shaders/textures, OpenGL states
 void rlglInit(int width, int height)
 {
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    // Allocate the software framebuffer, it replaces the OpenGL context
+    if (swInit(width, height)) TRACELOG(RL_LOG_INFO, "RLSW: Software renderer initialized successfully (%i x %i)", width, height);
+    else TRACELOG(RL_LOG_WARNING, "RLSW: Failed to initialize software renderer");
+#endif
+
     // Enable OpenGL debug context if required
 #if defined(RLGL_ENABLE_OPENGL_DEBUG_CONTEXT) && defined(GRAPHICS_API_OPENGL_43)
     if ((glDebugMessageCallback != NULL) && (glDebugMessageControl != NULL))
@@ -2305,6 +2481,10 @@ void rlglClose(void)
     glDeleteTextures(1, &RLGL.State.defaultTextureId); // Unload default texture
     TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Default texture unloaded successfully", RLGL.State.defaultTextureId);
 #endif
+
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    swClose();
+#endif
 }
 
 // Load OpenGL extensions
@@ -2352,6 +2532,7 @@ void rlLoadExtensions(void *loader)
     RLGL.ExtSupported.maxDepthBits = 32;
     RLGL.ExtSupported.texAnisoFilter = true;
     RLGL.ExtSupported.texMirrorClamp = true;
+    RLGL.ExtSupported.bufferStorage = GLAD_GL_ARB_buffer_storage;   // Core on OpenGL 4.4
 #endif
 
     // Optional OpenGL 3.3 extensions
@@ -2732,30 +2913,22 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
 
         // Quads - Vertex buffers binding and attributes enable
         // Vertex position buffer (shader-location = 0)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].vertices, GL_DYNAMIC_DRAW);
+        batch.vertexBuffer[i].vertices = (float *)rlLoadBatchStream(&batch.vertexBuffer[i], 0, batch.vertexBuffer[i].vertices, bufferElements*3*4*sizeof(float));
         glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
         glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
 
         // Vertex texcoord buffer (shader-location = 1)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[1]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[1]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*2*4*sizeof(float), batch.vertexBuffer[i].texcoords, GL_DYNAMIC_DRAW);
+        batch.vertexBuffer[i].texcoords = (float *)rlLoadBatchStream(&batch.vertexBuffer[i], 1, batch.vertexBuffer[i].texcoords, bufferElements*2*4*sizeof(float));
         glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
         glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
 
         // Vertex normal buffer (shader-location = 2)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[2]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[2]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].normals, GL_DYNAMIC_DRAW);
+        batch.vertexBuffer[i].normals = (float *)rlLoadBatchStream(&batch.vertexBuffer[i], 2, batch.vertexBuffer[i].normals, bufferElements*3*4*sizeof(float));
         glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL]);
         glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL], 3, GL_FLOAT, 0, 0, 0);
 
         // Vertex color buffer (shader-location = 3)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[3]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[3]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*4*4*sizeof(unsigned char), batch.vertexBuffer[i].colors, GL_DYNAMIC_DRAW);
+        batch.vertexBuffer[i].colors = (unsigned char *)rlLoadBatchStream(&batch.vertexBuffer[i], 3, batch.vertexBuffer[i].colors, bufferElements*4*4*sizeof(unsigned char));
         glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
         glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
 
@@ -2823,6 +2996,20 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
             glBindVertexArray(0);
         }
 
+#if defined(GRAPHICS_API_OPENGL_33)
+        // Unmap persistently mapped arrays, their memory belongs to the VBOs
+        for (int k = 0; k < 4; k++)
+        {
+            if (batch.vertexBuffer[i].mapped[k])
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[k]);
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if (batch.vertexBuffer[i].fence != NULL) glDeleteSync((GLsync)batch.vertexBuffer[i].fence);
+#endif
+
         // Delete VBOs from GPU (VRAM)
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[0]);
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[1]);
@@ -2834,10 +3021,17 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
         if (RLGL.ExtSupported.vao) glDeleteVertexArrays(1, &batch.vertexBuffer[i].vaoId);
 
         // Free vertex arrays memory from CPU (RAM)
+#if defined(GRAPHICS_API_OPENGL_33)
+        if (!batch.vertexBuffer[i].mapped[0]) RL_FREE(batch.vertexBuffer[i].vertices);
+        if (!batch.vertexBuffer[i].mapped[1]) RL_FREE(batch.vertexBuffer[i].texcoords);
+        if (!batch.vertexBuffer[i].mapped[2]) RL_FREE(batch.vertexBuffer[i].normals);
+        if (!batch.vertexBuffer[i].mapped[3]) RL_FREE(batch.vertexBuffer[i].colors);
+#else
         RL_FREE(batch.vertexBuffer[i].vertices);
         RL_FREE(batch.vertexBuffer[i].texcoords);
         RL_FREE(batch.vertexBuffer[i].normals);
         RL_FREE(batch.vertexBuffer[i].colors);
+#endif
         RL_FREE(batch.vertexBuffer[i].indices);
     }
 
@@ -2855,46 +3049,20 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
     // Update batch vertex buffers
     //------------------------------------------------------------------------------------------------------------
     // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
-    // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (use a change detector flag?)
+    // NOTE: Persistently mapped arrays are already in GPU memory, and streams the current shader
+    // doesn't read (e.g. normals for the default shader) are not uploaded at all
     if (RLGL.State.vertexCounter > 0)
     {
+        rlVertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+        rlStats.flushes++;
+
         // Activate elements VAO
-        if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
-
-        // Vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
-
-        // Texture coordinates buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
-
-        // Normals buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].normals);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].normals, GL_DYNAMIC_DRAW); // Update all buffer
-
-        // Colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
-
-        // NOTE: glMapBuffer() causes sync issue.
-        // If GPU is working with this buffer, glMapBuffer() will wait(stall) until GPU to finish its job.
-        // To avoid waiting (idle), you can call first glBufferData() with NULL pointer before glMapBuffer().
-        // If you do that, the previous data in PBO will be discarded and glMapBuffer() returns a new
-        // allocated pointer immediately even if GPU is still working with the previous data.
-
-        // Another option: map the buffer object into client's memory
-        // Probably this code could be moved somewhere else...
-        // batch->vertexBuffer[batch->currentBuffer].vertices = (float *)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
-        // if (batch->vertexBuffer[batch->currentBuffer].vertices)
-        // {
-            // Update vertex data
-        // }
-        // glUnmapBuffer(GL_ARRAY_BUFFER);
+        if (RLGL.ExtSupported.vao) glBindVertexArray(buffer->vaoId);
+
+        rlUpdateBatchStream(buffer, 0, RL_SHADER_LOC_VERTEX_POSITION, buffer->vertices, RLGL.State.vertexCounter*3*sizeof(float), buffer->elementCount*3*4*sizeof(float));
+        rlUpdateBatchStream(buffer, 1, RL_SHADER_LOC_VERTEX_TEXCOORD01, buffer->texcoords, RLGL.State.vertexCounter*2*sizeof(float), buffer->elementCount*2*4*sizeof(float));
+        rlUpdateBatchStream(buffer, 2, RL_SHADER_LOC_VERTEX_NORMAL, buffer->normals, RLGL.State.vertexCounter*3*sizeof(float), buffer->elementCount*3*4*sizeof(float));
+        rlUpdateBatchStream(buffer, 3, RL_SHADER_LOC_VERTEX_COLOR, buffer->colors, RLGL.State.vertexCounter*4*sizeof(unsigned char), buffer->elementCount*4*4*sizeof(unsigned char));
 
         // Unbind the current VAO
         if (RLGL.ExtSupported.vao) glBindVertexArray(0);
@@ -3004,6 +3172,9 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
             {
                 // Bind current draw call texture, activated as GL_TEXTURE0 and Bound to sampler2D texture0 by default
                 glBindTexture(GL_TEXTURE_2D, batch->draws[i].textureId);
+                if ((i == 0) || (batch->draws[i].textureId != batch->draws[i - 1].textureId)) rlStats.textureBinds++;
+                rlStats.drawCalls++;
+                rlStats.vertices += batch->draws[i].vertexCount;
 
                 if ((batch->draws[i].mode == RL_LINES) || (batch->draws[i].mode == RL_TRIANGLES)) glDrawArrays(batch->draws[i].mode, vertexOffset, batch->draws[i].vertexCount);
                 else
@@ -3038,6 +3209,14 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
 
     // Restore viewport to default measures
     if (eyeCount == 2) rlViewport(0, 0, RLGL.State.framebufferWidth, RLGL.State.framebufferHeight);
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    // Mapped arrays can't be written again until the GPU is done with these draws
+    if ((RLGL.State.vertexCounter > 0) && batch->vertexBuffer[batch->currentBuffer].mapped[0])
+    {
+        batch->vertexBuffer[batch->currentBuffer].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
     //------------------------------------------------------------------------------------------------------------
 
     // Reset batch buffers
@@ -3070,6 +3249,17 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
     // Change to next buffer in the list (in case of multi-buffering)
     batch->currentBuffer++;
     if (batch->currentBuffer >= batch->bufferCount) batch->currentBuffer = 0;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    // Wait for the GPU to release the next mapped buffer, with enough buffers in the ring it already did
+    rlVertexBuffer *next = &batch->vertexBuffer[batch->currentBuffer];
+    if (next->fence != NULL)
+    {
+        while (glClientWaitSync((GLsync)next->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) { }
+        glDeleteSync((GLsync)next->fence);
+        next->fence = NULL;
+    }
+#endif
 #endif
 }
 
@@ -3103,6 +3293,7 @@ bool rlCheckRenderBatchLimit(int vCount)
         (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4))
     {
         overflow = true;
+        rlStats.overflowFlushes++;
 
         // Store current primitive drawing mode and texture id
         int currentMode = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode;
@@ -3119,6 +3310,18 @@ bool rlCheckRenderBatchLimit(int vCount)
     return overflow;
 }
 
+// Get render statistics accumulated since last reset
+rlRenderStats rlGetRenderStats(void)
+{
+    return rlStats;
+}
+
+// Reset render statistics
+void rlResetRenderStats(void)
+{
+    rlStats = (rlRenderStats){ 0 };
+}
+
 // Textures data management
 //-----------------------------------------------------------------------------------------
 // Convert image data to OpenGL texture (returns OpenGL valid Id)
@@ -3418,6 +3621,7 @@ void rlUpdateTexture(unsigned int id, int offsetX, int offsetY, int width, int h
     if ((glInternalFormat != 0) && (format < RL_PIXELFORMAT_COMPRESSED_DXT1_RGB))
     {
         glTexSubImage2D(GL_TEXTURE_2D, 0, offsetX, offsetY, width, height, glFormat, glType, data);
+        rlStats.bytesUploaded += rlGetPixelDataSize(width, height, format);
     }
     else TRACELOG(RL_LOG_WARNING, "TEXTURE: [ID %i] Failed to update for current texture format (%i)", id, format);
 }
@@ -3626,6 +3830,72 @@ unsigned char *rlReadScreenPixels(int width, int height)
     return imgData;     // NOTE: image data should be freed
 }
 
+// Pixel buffers management
+//-----------------------------------------------------------------------------------------
+// Load a pixel pack buffer, used to read the screen back without stalling on the GPU
+// NOTE: Pixel buffers require OpenGL 2.1 or ES 3.0, not available on WebGL (no way to read them back without a stall)
+unsigned int rlLoadPixelBuffer(int size)
+{
+    unsigned int id = 0;
+
+#if defined(GRAPHICS_API_OPENGL_33) || (defined(GRAPHICS_API_OPENGL_ES3) && !defined(__EMSCRIPTEN__))
+    glGenBuffers(1, &id);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (id > 0) TRACELOG(RL_LOG_DEBUG, "PBO: [ID %i] Pixel buffer loaded successfully (%i bytes)", id, size);
+#endif
+
+    return id;
+}
+
+// Unload pixel pack buffer
+void rlUnloadPixelBuffer(unsigned int id)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || (defined(GRAPHICS_API_OPENGL_ES3) && !defined(__EMSCRIPTEN__))
+    glDeleteBuffers(1, &id);
+    TRACELOG(RL_LOG_DEBUG, "PBO: [ID %i] Unloaded pixel buffer data from VRAM (GPU)", id);
+#endif
+}
+
+// Start copying screen pixels into a pixel buffer
+// NOTE: glReadPixels() returns as soon as the copy is queued, read the buffer a frame or two later to avoid waiting for it
+void rlReadScreenPixelsToBuffer(unsigned int id, int width, int height)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || (defined(GRAPHICS_API_OPENGL_ES3) && !defined(__EMSCRIPTEN__))
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
+}
+
+// Get pixel buffer data, as returned by glReadPixels(): (0,0) is the bottom left corner
+bool rlReadPixelBuffer(unsigned int id, unsigned char *data, int size)
+{
+    bool result = false;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, size, data);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    result = true;
+#elif defined(GRAPHICS_API_OPENGL_ES3) && !defined(__EMSCRIPTEN__)
+    // NOTE: OpenGL ES has no glGetBufferSubData(), the buffer must be mapped
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, id);
+    void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (mapped != NULL)
+    {
+        memcpy(data, mapped, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        result = true;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
+
+    return result;
+}
+
 // Framebuffer management (fbo)
 //-----------------------------------------------------------------------------------------
 // Load a framebuffer to be used for rendering
@@ -3814,6 +4084,7 @@ void rlUpdateVertexBuffer(unsigned int id, const void *data, int dataSize, int o
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     glBindBuffer(GL_ARRAY_BUFFER, id);
     glBufferSubData(GL_ARRAY_BUFFER, offset, dataSize, data);
+    rlStats.bytesUploaded += dataSize;
 #endif
 }
 
@@ -3824,6 +4095,7 @@ void rlUpdateVertexBufferElements(unsigned int id, const void *data, int dataSiz
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id);
     glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, dataSize, data);
+    rlStats.bytesUploaded += dataSize;
 #endif
 }
 
@@ -3869,6 +4141,8 @@ void rlDisableVertexAttribute(unsigned int index)
 void rlDrawVertexArray(int offset, int count)
 {
     glDrawArrays(GL_TRIANGLES, offset, count);
+    rlStats.drawCalls++;
+    rlStats.vertices += count;
 }
 
 // Draw vertex array elements
@@ -3879,6 +4153,8 @@ void rlDrawVertexArrayElements(int offset, int count, const void *buffer)
     if (offset > 0) bufferPtr += offset;
 
     glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, (const unsigned short *)bufferPtr);
+    rlStats.drawCalls++;
+    rlStats.vertices += count;
 }
 
 // Draw vertex array instanced
@@ -3886,6 +4162,8 @@ void rlDrawVertexArrayInstanced(int offset, int count, int instances)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     glDrawArraysInstanced(GL_TRIANGLES, 0, count, instances);
+    rlStats.drawCalls++;
+    rlStats.vertices += count*instances;
 #endif
 }
 
@@ -3898,6 +4176,8 @@ void rlDrawVertexArrayElementsInstanced(int offset, int count, const void *buffe
     if (offset > 0) bufferPtr += offset;
 
     glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, (const unsigned short *)bufferPtr, instances);
+    rlStats.drawCalls++;
+    rlStats.vertices += count*instances;
 #endif
 }
 
@@ -4300,6 +4580,7 @@ void rlSetShader(unsigned int id, int *locs)
         rlDrawRenderBatch(RLGL.currentBatch);
         RLGL.State.currentShaderId = id;
         RLGL.State.currentShaderLocs = locs;
+        rlStats.stateChanges++;
     }
 #endif
 }
@@ -4391,6 +4672,7 @@ void rlUpdateShaderBuffer(unsigned int id, const void *data, unsigned int dataSi
 #if defined(GRAPHICS_API_OPENGL_43)
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, id);
     glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, dataSize, data);
+    rlStats.bytesUploaded += (int)dataSize;
 #endif
 }
 
@@ -4855,6 +5137,58 @@ static void rlUnloadShaderDefault(void)
     TRACELOG(RL_LOG_INFO, "SHADER: [ID %i] Default shader unloaded successfully", RLGL.State.defaultShaderId);
 }
 
+// Load a batch vertex stream VBO (bound on return), returns the array to write vertex data into
+// NOTE: When persistent mapping is supported, the returned array is the mapped VBO memory and data is freed,
+// the immutable storage is created with GL_DYNAMIC_STORAGE_BIT so a failed map falls back to glBufferSubData()
+static void *rlLoadBatchStream(rlVertexBuffer *buffer, int stream, void *data, int size)
+{
+    glGenBuffers(1, &buffer->vboId[stream]);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer->vboId[stream]);
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    buffer->mapped[stream] = false;
+    buffer->fence = NULL;
+
+    if (RLGL.ExtSupported.bufferStorage)
+    {
+        GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, data, mapFlags | GL_DYNAMIC_STORAGE_BIT);
+
+        void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, mapFlags);
+        if (mapped != NULL)
+        {
+            RL_FREE(data);
+            buffer->mapped[stream] = true;
+            return mapped;
+        }
+
+        TRACELOG(RL_LOG_WARNING, "RLGL: Failed to map render batch buffer, uploading it on draw");
+        return data;
+    }
+#endif
+
+    glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+    return data;
+}
+
+// Upload a batch vertex stream for drawing, if required
+// NOTE: On desktop the buffer is orphaned first, so the upload never waits for draws still reading it
+static void rlUpdateBatchStream(rlVertexBuffer *buffer, int stream, int shaderLoc, const void *data, int size, int capacity)
+{
+    if (RLGL.State.currentShaderLocs[shaderLoc] == -1) return;
+
+    rlStats.bytesUploaded += size;      // NOTE: Mapped arrays are written straight to GPU memory, still counted
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (buffer->mapped[stream]) return;
+#endif
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer->vboId[stream]);
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (!RLGL.ExtSupported.bufferStorage) glBufferData(GL_ARRAY_BUFFER, capacity, NULL, GL_DYNAMIC_DRAW);
+#endif
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+}
+
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 // Get compressed format official GL identifier name
 static const char *rlGetCompressedFormatName(int format)
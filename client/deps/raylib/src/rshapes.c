@@ -668,15 +668,34 @@ void DrawRectangle(int posX, int posY, int width, int height, Color color)
 
 // Draw a color-filled rectangle (Vector version)
 // NOTE: On OpenGL 3.3 and ES2 we use QUADS to avoid drawing order issues
+// NOTE: Unrotated rectangles skip the corner transforms of DrawRectanglePro(),
+// the quad is written into the batch at once with rlRectangle2f()
 void DrawRectangleV(Vector2 position, Vector2 size, Color color)
 {
+#if defined(SUPPORT_QUADS_DRAW_MODE)
+    rlSetTexture(texShapes.id);
+
+    rlBegin(RL_QUADS);
+
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        rlRectangle2f(position.x, position.y, size.x, size.y,
+            texShapesRec.x/texShapes.width, texShapesRec.y/texShapes.height,
+            (texShapesRec.x + texShapesRec.width)/texShapes.width, (texShapesRec.y + texShapesRec.height)/texShapes.height);
+
+    rlEnd();
+
+    rlSetTexture(0);
+#else
     DrawRectanglePro((Rectangle){ position.x, position.y, size.x, size.y }, (Vector2){ 0.0f, 0.0f }, 0.0f, color);
+#endif
 }
 
 // Draw a color-filled rectangle
 void DrawRectangleRec(Rectangle rec, Color color)
 {
-    DrawRectanglePro(rec, (Vector2){ 0.0f, 0.0f }, 0.0f, color);
+    DrawRectangleV((Vector2){ rec.x, rec.y }, (Vector2){ rec.width, rec.height }, color);
 }
 
 // Draw a color-filled rectangle with pro parameters
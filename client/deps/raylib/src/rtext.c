@@ -115,11 +115,26 @@
 #ifndef MAX_TEXTSPLIT_COUNT
     #define MAX_TEXTSPLIT_COUNT                  128        // Maximum number of substrings to split: TextSplit()
 #endif
+#ifndef MAX_GLYPH_LOOKUP_FONTS
+    #define MAX_GLYPH_LOOKUP_FONTS                 8        // Maximum number of loaded fonts with a codepoint lookup table: GetGlyphIndex()
+#endif
+#ifndef MAX_GLYPH_LOOKUP_CODEPOINT
+    #define MAX_GLYPH_LOOKUP_CODEPOINT        0xffff        // Maximum codepoint covered by lookup tables, above it glyphs are searched: GetGlyphIndex()
+#endif
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-//...
+// Codepoint to glyph index table of a loaded font
+// NOTE: Font struct is passed by value, the table is found by the glyphs array it was built for
+typedef struct GlyphLookup {
+    const GlyphInfo *glyphs;        // Glyphs of the font the table was built for, NULL if unused
+    int glyphCount;                 // Glyphs count of the font, to validate the match
+    int maxCodepoint;               // Greatest codepoint in the font
+    int fallbackIndex;              // Glyph index of '?', returned for codepoints not in the font
+    int indexCount;                 // Codepoints covered by the table: [0..indexCount)
+    int *indices;                   // Glyph index for every covered codepoint
+} GlyphLookup;
 
 //----------------------------------------------------------------------------------
 // Global variables
@@ -130,6 +145,8 @@
 static Font defaultFont = { 0 };
 #endif
 
+static GlyphLookup glyphLookups[MAX_GLYPH_LOOKUP_FONTS] = { 0 };    // Lookup tables of loaded fonts
+
 //----------------------------------------------------------------------------------
 // Other Modules Functions Declaration (required by text)
 //----------------------------------------------------------------------------------
@@ -146,6 +163,9 @@ static GlyphInfo *LoadFontDataBDF(const unsigned char *fileData, int dataSize, i
 #endif
 static int textLineSpacing = 2;                 // Text vertical line spacing in pixels (between lines)
 
+static void LoadGlyphLookup(Font font);         // Build the codepoint lookup table of a loaded font
+static void UnloadGlyphLookup(Font font);       // Free the codepoint lookup table of a font
+
 #if defined(SUPPORT_DEFAULT_FONT)
 extern void LoadFontDefault(void);
 extern void UnloadFontDefault(void);
@@ -301,12 +321,15 @@ extern void LoadFontDefault(void)
 
     defaultFont.baseSize = (int)defaultFont.recs[0].height;
 
+    LoadGlyphLookup(defaultFont);
+
     TRACELOG(LOG_INFO, "FONT: Default font loaded successfully (%i glyphs)", defaultFont.glyphCount);
 }
 
 // Unload raylib default font
 extern void UnloadFontDefault(void)
 {
+    UnloadGlyphLookup(defaultFont);
     for (int i = 0; i < defaultFont.glyphCount; i++) UnloadImage(defaultFont.glyphs[i].image);
     UnloadTexture(defaultFont.texture);
     RL_FREE(defaultFont.glyphs);
@@ -516,6 +539,8 @@ Font LoadFontFromImage(Image image, Color key, int firstChar)
 
     font.baseSize = (int)font.recs[0].height;
 
+    LoadGlyphLookup(font);
+
     return font;
 }
 
@@ -567,6 +592,8 @@ Font LoadFontFromMemory(const char *fileType, const unsigned char *fileData, int
 
         UnloadImage(atlas);
 
+        LoadGlyphLookup(font);
+
         TRACELOG(LOG_INFO, "FONT: Data loaded successfully (%i pixel size | %i glyphs)", font.baseSize, font.glyphCount);
     }
     else font = GetFontDefault();
@@ -945,6 +972,7 @@ void UnloadFont(Font font)
     // NOTE: Make sure font is not default font (fallback)
     if (font.texture.id != GetFontDefault().texture.id)
     {
+        UnloadGlyphLookup(font);
         UnloadFontData(font.glyphs, font.glyphCount);
         UnloadTexture(font.texture);
         RL_FREE(font.recs);
@@ -1334,6 +1362,19 @@ int GetGlyphIndex(Font font, int codepoint)
 {
     int index = 0;
 
+    // Fonts loaded by raylib get a direct lookup table on load, no need to search the glyphs
+    for (int i = 0; i < MAX_GLYPH_LOOKUP_FONTS; i++)
+    {
+        const GlyphLookup *lookup = &glyphLookups[i];
+
+        if ((lookup->glyphs != NULL) && (lookup->glyphs == font.glyphs) && (lookup->glyphCount == font.glyphCount))
+        {
+            if ((codepoint >= 0) && (codepoint < lookup->indexCount)) return lookup->indices[codepoint];
+            if ((codepoint < 0) || (codepoint > lookup->maxCodepoint)) return lookup->fallbackIndex;
+            break;      // Codepoint above the table but in the font, search it
+        }
+    }
+
 #define SUPPORT_UNORDERED_CHARSET
 #if defined(SUPPORT_UNORDERED_CHARSET)
     int fallbackIndex = 0;      // Get index of fallback glyph '?'
@@ -2129,6 +2170,60 @@ int GetCodepointPrevious(const char *text, int *codepointSize)
 //----------------------------------------------------------------------------------
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
+// Build the codepoint lookup table of a loaded font
+// NOTE: Matches the glyphs search in GetGlyphIndex(): first glyph with the codepoint, last '?' as fallback
+static void LoadGlyphLookup(Font font)
+{
+    if ((font.glyphs == NULL) || (font.glyphCount <= 0)) return;
+
+    GlyphLookup *lookup = NULL;
+    for (int i = 0; i < MAX_GLYPH_LOOKUP_FONTS; i++)
+    {
+        if (glyphLookups[i].glyphs == NULL) { lookup = &glyphLookups[i]; break; }
+    }
+
+    if (lookup == NULL)
+    {
+        TRACELOG(LOG_WARNING, "FONT: Too many fonts loaded for glyph lookup tables, glyphs will be searched (max: %i)", MAX_GLYPH_LOOKUP_FONTS);
+        return;
+    }
+
+    lookup->fallbackIndex = 0;
+    lookup->maxCodepoint = 0;
+    for (int i = 0; i < font.glyphCount; i++)
+    {
+        if (font.glyphs[i].value == 63) lookup->fallbackIndex = i;
+        if (font.glyphs[i].value > lookup->maxCodepoint) lookup->maxCodepoint = font.glyphs[i].value;
+    }
+
+    lookup->indexCount = ((lookup->maxCodepoint < MAX_GLYPH_LOOKUP_CODEPOINT)? lookup->maxCodepoint : MAX_GLYPH_LOOKUP_CODEPOINT) + 1;
+    lookup->indices = (int *)RL_MALLOC(lookup->indexCount*sizeof(int));
+    for (int c = 0; c < lookup->indexCount; c++) lookup->indices[c] = lookup->fallbackIndex;
+
+    // Backwards, so the first glyph with a given codepoint is the one kept
+    for (int i = font.glyphCount - 1; i >= 0; i--)
+    {
+        int codepoint = font.glyphs[i].value;
+        if ((codepoint >= 0) && (codepoint < lookup->indexCount)) lookup->indices[codepoint] = i;
+    }
+
+    lookup->glyphs = font.glyphs;
+    lookup->glyphCount = font.glyphCount;
+}
+
+// Free the codepoint lookup table of a font
+static void UnloadGlyphLookup(Font font)
+{
+    for (int i = 0; i < MAX_GLYPH_LOOKUP_FONTS; i++)
+    {
+        if ((glyphLookups[i].glyphs != NULL) && (glyphLookups[i].glyphs == font.glyphs))
+        {
+            RL_FREE(glyphLookups[i].indices);
+            glyphLookups[i] = (GlyphLookup){ 0 };
+        }
+    }
+}
+
 #if defined(SUPPORT_FILEFORMAT_FNT) || defined(SUPPORT_FILEFORMAT_BDF)
 // Read a line from memory
 // REQUIRES: memcpy()
@@ -2306,7 +2401,11 @@ static Font LoadBMFont(const char *fileName)
         font = GetFontDefault();
         TRACELOG(LOG_WARNING, "FONT: [%s] Failed to load texture, reverted to default font", fileName);
     }
-    else TRACELOG(LOG_INFO, "FONT: [%s] Font loaded successfully (%i glyphs)", fileName, font.glyphCount);
+    else
+    {
+        LoadGlyphLookup(font);
+        TRACELOG(LOG_INFO, "FONT: [%s] Font loaded successfully (%i glyphs)", fileName, font.glyphCount);
+    }
 
     return font;
 }
@@ -837,6 +837,18 @@ unsigned char *ExportImageToMemory(Image image, const char *fileType, int *dataS
         fileData = stbi_write_png_to_mem((const unsigned char *)image.data, image.width*channels, image.width, image.height, channels, dataSize);
     }
 #endif
+#if defined(SUPPORT_FILEFORMAT_QOI)
+    if (((strcmp(fileType, ".qoi") == 0) || (strcmp(fileType, ".QOI") == 0)) && ((channels == 3) || (channels == 4)))
+    {
+        qoi_desc desc = { 0 };
+        desc.width = image.width;
+        desc.height = image.height;
+        desc.channels = channels;
+        desc.colorspace = QOI_SRGB;
+
+        fileData = (unsigned char *)qoi_encode(image.data, &desc, dataSize);
+    }
+#endif
 
 #endif
 
@@ -0,0 +1,232 @@
+#include "drawlist.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+// Draw mode and texture id are the low bits of the key, anything sharing them goes in the same rlgl draw call
+#define BATCH_KEY_MASK 0xFFFFFFFFFFULL
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum {
+    COMMAND_RECTANGLE = 0,
+    COMMAND_RECTANGLE_LINES,
+    COMMAND_LINE,
+    COMMAND_TEXT,
+    COMMAND_TEXTURE,
+    COMMAND_TEXT_LAYOUT,
+} DrawCommandKind;
+
+typedef struct DrawCommand {
+    unsigned long long key; // Layer, then draw mode, then texture id
+    int sequence; // Recording order, keeps the sort stable
+    DrawCommandKind kind;
+    Color color;
+    union {
+        struct {
+            Rectangle rec;
+            float thick;
+        } rectangle;
+        struct {
+            Vector2 start;
+            Vector2 end;
+        } line;
+        struct {
+            int offset; // Into listText
+            int x;
+            int y;
+            int size;
+        } text;
+        struct {
+            Texture2D texture;
+            Rectangle source;
+            Rectangle dest;
+        } texture;
+        struct {
+            const TextLayout *layout;
+            Vector2 position;
+        } layout;
+    } as;
+} DrawCommand;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static DrawCommand commands[MAX_DRAW_COMMANDS] = { 0 };
+static int commandCount = 0;
+static int droppedCount = 0;
+static char listText[MAX_DRAW_LIST_TEXT] = { 0 };
+static int listTextLength = 0;
+static DrawListStats stats = { 0 };
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions (local)
+//------------------------------------------------------------------------------------
+
+static inline unsigned long long make_key(int layer, int mode, unsigned int texture)
+{
+    unsigned long long clamped = layer < 0 ? 0 : layer > 0xFF ? 0xFF : layer;
+    return (clamped << 40) | ((unsigned long long)mode << 32) | texture;
+}
+
+static DrawCommand *push_command(int layer, int mode, unsigned int texture, DrawCommandKind kind, Color color)
+{
+    if (commandCount == MAX_DRAW_COMMANDS) {
+        droppedCount++;
+        return NULL;
+    }
+    DrawCommand *command = &commands[commandCount];
+    command->key = make_key(layer, mode, texture);
+    command->sequence = commandCount;
+    command->kind = kind;
+    command->color = color;
+    commandCount++;
+    return command;
+}
+
+static int compare_commands(const void *a, const void *b)
+{
+    const DrawCommand *ca = a;
+    const DrawCommand *cb = b;
+    if (ca->key != cb->key) {
+        return ca->key < cb->key ? -1 : 1;
+    }
+    return ca->sequence - cb->sequence;
+}
+
+static int count_draw_calls(void)
+{
+    int draw_calls = 0;
+    for (int i = 0; i < commandCount; i++) {
+        if (i == 0 || (commands[i].key & BATCH_KEY_MASK) != (commands[i - 1].key & BATCH_KEY_MASK)) {
+            draw_calls++;
+        }
+    }
+    return draw_calls;
+}
+
+static void submit_command(const DrawCommand *command)
+{
+    switch (command->kind) {
+    case COMMAND_RECTANGLE:
+        DrawRectangleRec(command->as.rectangle.rec, command->color);
+        break;
+    case COMMAND_RECTANGLE_LINES:
+        DrawRectangleLinesEx(command->as.rectangle.rec, command->as.rectangle.thick, command->color);
+        break;
+    case COMMAND_LINE:
+        DrawLineV(command->as.line.start, command->as.line.end, command->color);
+        break;
+    case COMMAND_TEXT:
+        DrawText(&listText[command->as.text.offset], command->as.text.x, command->as.text.y, command->as.text.size, command->color);
+        break;
+    case COMMAND_TEXTURE:
+        DrawTexturePro(command->as.texture.texture, command->as.texture.source, command->as.texture.dest, (Vector2) { 0 }, 0.0f, command->color);
+        break;
+    case COMMAND_TEXT_LAYOUT:
+        DrawTextLayout(command->as.layout.layout, command->as.layout.position, command->color);
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+void BeginDrawList(void)
+{
+    commandCount = 0;
+    droppedCount = 0;
+    listTextLength = 0;
+}
+
+void EndDrawList(void)
+{
+    int unsorted_draw_calls = count_draw_calls();
+    qsort(commands, commandCount, sizeof(DrawCommand), compare_commands);
+
+    stats.commands = commandCount;
+    stats.dropped = droppedCount;
+    stats.draw_calls = count_draw_calls();
+    stats.draw_calls_saved = unsorted_draw_calls - stats.draw_calls;
+
+    for (int i = 0; i < commandCount; i++) {
+        submit_command(&commands[i]);
+    }
+
+    commandCount = 0;
+    listTextLength = 0;
+}
+
+DrawListStats GetDrawListStats(void)
+{
+    return stats;
+}
+
+void DrawListRectangle(int layer, Rectangle rec, Color color)
+{
+    DrawCommand *command = push_command(layer, RL_QUADS, GetShapesTexture().id, COMMAND_RECTANGLE, color);
+    if (command != NULL) {
+        command->as.rectangle.rec = rec;
+    }
+}
+
+void DrawListRectangleLines(int layer, Rectangle rec, float lineThick, Color color)
+{
+    DrawCommand *command = push_command(layer, RL_QUADS, GetShapesTexture().id, COMMAND_RECTANGLE_LINES, color);
+    if (command != NULL) {
+        command->as.rectangle.rec = rec;
+        command->as.rectangle.thick = lineThick;
+    }
+}
+
+void DrawListLine(int layer, Vector2 startPos, Vector2 endPos, Color color)
+{
+    DrawCommand *command = push_command(layer, RL_LINES, rlGetTextureIdDefault(), COMMAND_LINE, color);
+    if (command != NULL) {
+        command->as.line.start = startPos;
+        command->as.line.end = endPos;
+    }
+}
+
+void DrawListText(int layer, const char *text, int posX, int posY, int fontSize, Color color)
+{
+    int length = strlen(text) + 1;
+    if (listTextLength + length > MAX_DRAW_LIST_TEXT) {
+        droppedCount++;
+        return;
+    }
+
+    DrawCommand *command = push_command(layer, RL_QUADS, GetFontDefault().texture.id, COMMAND_TEXT, color);
+    if (command != NULL) {
+        memcpy(&listText[listTextLength], text, length);
+        command->as.text.offset = listTextLength;
+        command->as.text.x = posX;
+        command->as.text.y = posY;
+        command->as.text.size = fontSize;
+        listTextLength += length;
+    }
+}
+
+void DrawListTexture(int layer, Texture2D texture, Rectangle source, Rectangle dest, Color tint)
+{
+    DrawCommand *command = push_command(layer, RL_QUADS, texture.id, COMMAND_TEXTURE, tint);
+    if (command != NULL) {
+        command->as.texture.texture = texture;
+        command->as.texture.source = source;
+        command->as.texture.dest = dest;
+    }
+}
+
+void DrawListTextLayout(int layer, const TextLayout *layout, Vector2 position, Color tint)
+{
+    DrawCommand *command = push_command(layer, RL_QUADS, layout->font.texture.id, COMMAND_TEXT_LAYOUT, tint);
+    if (command != NULL) {
+        command->as.layout.layout = layout;
+        command->as.layout.position = position;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include "raylib.h"
+#include "textlayout.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MAX_DRAW_COMMANDS 1024
+#define MAX_DRAW_LIST_TEXT 8192 // Bytes of text recorded per list, strings are copied on record
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Counters of the last submitted list, a draw call is counted for every change of mode or texture
+typedef struct DrawListStats {
+    int commands;
+    int dropped; // Commands that didn't fit in the list
+    int draw_calls; // As submitted, after sorting
+    int draw_calls_saved; // Compared to submitting in recording order
+} DrawListStats;
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+// Commands are recorded with a layer and submitted by EndDrawList() in ascending layer order. Inside a layer
+// they are grouped by draw mode and texture, so the order between commands of the same layer isn't kept,
+// only the order between commands that share mode and texture is
+void BeginDrawList(void); // Start recording, drops anything recorded but not submitted
+void EndDrawList(void); // Sort and submit everything recorded to rlgl
+DrawListStats GetDrawListStats(void); // Get the counters of the last submitted list
+
+void DrawListRectangle(int layer, Rectangle rec, Color color); // Record a color-filled rectangle
+void DrawListRectangleLines(int layer, Rectangle rec, float lineThick, Color color); // Record a rectangle outline made of quads
+void DrawListLine(int layer, Vector2 startPos, Vector2 endPos, Color color); // Record a line, drawn in line mode
+void DrawListText(int layer, const char *text, int posX, int posY, int fontSize, Color color); // Record text with the default font
+void DrawListTexture(int layer, Texture2D texture, Rectangle source, Rectangle dest, Color tint); // Record a part of a texture
+void DrawListTextLayout(int layer, const TextLayout *layout, Vector2 position, Color tint); // Record laid out text, the layout must not change until the list is submitted
+
+#endif // DRAWLIST_H
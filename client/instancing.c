@@ -0,0 +1,156 @@
+#include "instancing.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define QUAD_VERTEX_COUNT 6 // rlDrawVertexArrayInstanced() draws triangles
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+
+// Instance position and size come straight from RectInstance, the unit quad is stretched over it
+static const char *instancingVertexShader = "in vec2 vertexPosition;\n"
+                                            "in vec4 instanceRect;\n"
+                                            "uniform mat4 mvp;\n"
+                                            "uniform vec4 palette[16];\n"
+                                            "out vec4 fragColor;\n"
+                                            "void main()\n"
+                                            "{\n"
+                                            "    fragColor = palette[int(instanceRect.w)];\n"
+                                            "    gl_Position = mvp * vec4(instanceRect.xy + vertexPosition * instanceRect.z, 0.0, 1.0);\n"
+                                            "}\n";
+
+static const char *instancingFragmentShader = "in vec4 fragColor;\n"
+                                              "out vec4 finalColor;\n"
+                                              "void main()\n"
+                                              "{\n"
+                                              "    finalColor = fragColor;\n"
+                                              "}\n";
+
+static const float unitQuad[QUAD_VERTEX_COUNT * 2] = {
+    0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
+    0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f
+};
+
+static bool supported = false;
+static int instanceCapacity = 0;
+static unsigned int shaderId = 0;
+static int mvpLoc = -1;
+static int paletteLoc = -1;
+static unsigned int vaoId = 0;
+static unsigned int quadVboId = 0;
+static unsigned int instanceVboId = 0;
+
+static Color palette[MAX_INSTANCE_COLORS] = { 0 };
+static Vector4 paletteNormalized[MAX_INSTANCE_COLORS] = { 0 };
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+void InitInstancing(int capacity)
+{
+    int version = rlGetVersion();
+    if (version != RL_OPENGL_33 && version != RL_OPENGL_43 && version != RL_OPENGL_ES_30) {
+        TraceLog(LOG_INFO, "INSTANCING: Not supported by the graphics API, falling back to batched rectangles");
+        return;
+    }
+
+    // Both GLSL 330 and GLSL 300 es accept the same body, only the header differs
+    const char *header = version == RL_OPENGL_ES_30 ? "#version 300 es\nprecision mediump float;\n" : "#version 330\n";
+    char *vs = malloc(strlen(header) + strlen(instancingVertexShader) + 1);
+    char *fs = malloc(strlen(header) + strlen(instancingFragmentShader) + 1);
+    strcat(strcpy(vs, header), instancingVertexShader);
+    strcat(strcpy(fs, header), instancingFragmentShader);
+    shaderId = rlLoadShaderCode(vs, fs);
+    free(vs);
+    free(fs);
+
+    if (shaderId == rlGetShaderIdDefault()) {
+        TraceLog(LOG_WARNING, "INSTANCING: Failed to load shader, falling back to batched rectangles");
+        return;
+    }
+
+    mvpLoc = rlGetLocationUniform(shaderId, "mvp");
+    paletteLoc = rlGetLocationUniform(shaderId, "palette");
+    int positionLoc = rlGetLocationAttrib(shaderId, "vertexPosition");
+    int instanceLoc = rlGetLocationAttrib(shaderId, "instanceRect");
+
+    vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(vaoId);
+
+    quadVboId = rlLoadVertexBuffer(unitQuad, sizeof(unitQuad), false);
+    rlSetVertexAttribute(positionLoc, 2, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(positionLoc);
+
+    instanceVboId = rlLoadVertexBuffer(NULL, capacity * sizeof(RectInstance), true);
+    rlSetVertexAttribute(instanceLoc, 4, RL_FLOAT, false, sizeof(RectInstance), 0);
+    rlSetVertexAttributeDivisor(instanceLoc, 1);
+    rlEnableVertexAttribute(instanceLoc);
+
+    rlDisableVertexArray();
+
+    instanceCapacity = capacity;
+    supported = true;
+}
+
+void UnloadInstancing(void)
+{
+    if (!supported) {
+        return;
+    }
+    rlUnloadVertexArray(vaoId);
+    rlUnloadVertexBuffer(quadVboId);
+    rlUnloadVertexBuffer(instanceVboId);
+    rlUnloadShaderProgram(shaderId);
+    supported = false;
+}
+
+bool IsInstancingSupported(void)
+{
+    return supported;
+}
+
+void SetInstancePalette(const Color *colors, int count)
+{
+    for (int i = 0; i < count && i < MAX_INSTANCE_COLORS; i++) {
+        palette[i] = colors[i];
+        paletteNormalized[i] = ColorNormalize(colors[i]);
+    }
+}
+
+void DrawRectInstances(const RectInstance *instances, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    if (!supported) {
+        for (int i = 0; i < count; i++) {
+            DrawRectangleV((Vector2) { instances[i].x, instances[i].y }, (Vector2) { instances[i].size, instances[i].size }, palette[(int)instances[i].color]);
+        }
+        return;
+    }
+
+    // Anything already queued in the rlgl batch has to land below the instances
+    rlDrawRenderBatchActive();
+
+    rlEnableShader(shaderId);
+    rlSetUniformMatrix(mvpLoc, MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlSetUniform(paletteLoc, paletteNormalized, RL_SHADER_UNIFORM_VEC4, MAX_INSTANCE_COLORS);
+    rlEnableVertexArray(vaoId);
+
+    for (int first = 0; first < count; first += instanceCapacity) {
+        int chunk = count - first < instanceCapacity ? count - first : instanceCapacity;
+        rlUpdateVertexBuffer(instanceVboId, instances + first, chunk * sizeof(RectInstance), 0);
+        rlDrawVertexArrayInstanced(0, QUAD_VERTEX_COUNT, chunk);
+    }
+
+    rlDisableVertexArray();
+    rlDisableShader();
+}
@@ -0,0 +1,32 @@
+#ifndef INSTANCING_H
+#define INSTANCING_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MAX_INSTANCE_COLORS 16
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// A single axis-aligned square, laid out exactly the way the instancing shader reads it
+typedef struct RectInstance {
+    float x; // Top left corner
+    float y;
+    float size;
+    float color; // Index into the instance palette
+} RectInstance;
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+void InitInstancing(int capacity); // Load the instancing shader and buffers, capacity is the max instances per draw call
+void UnloadInstancing(void); // Unload the instancing shader and buffers
+bool IsInstancingSupported(void); // Check if instances are drawn on the GPU (OpenGL 3.3+ and ES 3.0)
+void SetInstancePalette(const Color *colors, int count); // Set the colors RectInstance.color indexes into
+void DrawRectInstances(const RectInstance *instances, int count); // Draw all the instances, one draw call per `capacity` instances
+
+#endif // INSTANCING_H
@@ -0,0 +1,180 @@
+#include "overlay.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define AA_PIXELS 1.5f // Quads are grown by this many pixels so the antialiased edge isn't clipped
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+
+// Every shape is a rounded rectangle: a circle is one with the corner radius equal to its half size. Each quad carries:
+//  - texcoord: the corner position relative to the shape center, interpolated into the fragment position
+//  - normal: corner radius, line thickness (0 to fill) and the margin the quad was grown by
+// so the half size can be recovered in the vertex shader and a whole batch of shapes shares one draw call
+static const char *overlayVertexShader = "in vec3 vertexPosition;\n"
+                                         "in vec2 vertexTexCoord;\n"
+                                         "in vec3 vertexNormal;\n"
+                                         "in vec4 vertexColor;\n"
+                                         "uniform mat4 mvp;\n"
+                                         "out vec2 fragLocal;\n"
+                                         "out vec2 fragHalfSize;\n"
+                                         "out vec2 fragShape;\n"
+                                         "out vec4 fragColor;\n"
+                                         "void main()\n"
+                                         "{\n"
+                                         "    fragLocal = vertexTexCoord;\n"
+                                         "    fragHalfSize = abs(vertexTexCoord) - vertexNormal.z;\n"
+                                         "    fragShape = vertexNormal.xy;\n"
+                                         "    fragColor = vertexColor;\n"
+                                         "    gl_Position = mvp * vec4(vertexPosition, 1.0);\n"
+                                         "}\n";
+
+static const char *overlayFragmentShader = "in vec2 fragLocal;\n"
+                                           "in vec2 fragHalfSize;\n"
+                                           "in vec2 fragShape;\n"
+                                           "in vec4 fragColor;\n"
+                                           "out vec4 finalColor;\n"
+                                           "void main()\n"
+                                           "{\n"
+                                           "    float radius = fragShape.x;\n"
+                                           "    float thick = fragShape.y;\n"
+                                           "    vec2 q = abs(fragLocal) - fragHalfSize + radius;\n"
+                                           "    float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;\n"
+                                           "    if (thick > 0.0) d = abs(d + thick * 0.5) - thick * 0.5;\n"
+                                           "    float alpha = clamp(0.5 - d / max(fwidth(d), 0.0001), 0.0, 1.0);\n"
+                                           "    finalColor = vec4(fragColor.rgb, fragColor.a * alpha);\n"
+                                           "}\n";
+
+static bool supported = false;
+static Shader shader = { 0 };
+static float margin = AA_PIXELS; // In world units, updated by BeginOverlays() from the current transform
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions (local)
+//------------------------------------------------------------------------------------
+
+static void push_shape(Vector2 center, Vector2 halfSize, float cornerRadius, float lineThick, Color color)
+{
+    float hx = halfSize.x + margin;
+    float hy = halfSize.y + margin;
+
+    rlBegin(RL_QUADS);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlNormal3f(cornerRadius, lineThick > 0.0f ? lineThick : 0.0f, margin);
+    rlRectangle2f(center.x - hx, center.y - hy, hx * 2, hy * 2, -hx, -hy, hx, hy);
+    rlEnd();
+}
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+void InitOverlays(void)
+{
+    int version = rlGetVersion();
+    if (version != RL_OPENGL_33 && version != RL_OPENGL_43 && version != RL_OPENGL_ES_30) {
+        TraceLog(LOG_INFO, "OVERLAY: Not supported by the graphics API, falling back to tessellated shapes");
+        return;
+    }
+
+    // Same as instancing, GLSL 330 and GLSL 300 es only differ in the header
+    const char *header = version == RL_OPENGL_ES_30 ? "#version 300 es\nprecision mediump float;\n" : "#version 330\n";
+    char *vs = malloc(strlen(header) + strlen(overlayVertexShader) + 1);
+    char *fs = malloc(strlen(header) + strlen(overlayFragmentShader) + 1);
+    strcat(strcpy(vs, header), overlayVertexShader);
+    strcat(strcpy(fs, header), overlayFragmentShader);
+    shader = LoadShaderFromMemory(vs, fs);
+    free(vs);
+    free(fs);
+
+    // The normal stream is only uploaded for shaders that read it
+    if (shader.id == rlGetShaderIdDefault() || shader.locs[SHADER_LOC_VERTEX_NORMAL] == -1) {
+        TraceLog(LOG_WARNING, "OVERLAY: Failed to load shader, falling back to tessellated shapes");
+        UnloadShader(shader);
+        shader = (Shader) { 0 };
+        return;
+    }
+
+    supported = true;
+}
+
+void UnloadOverlays(void)
+{
+    if (!supported) {
+        return;
+    }
+    UnloadShader(shader);
+    shader = (Shader) { 0 };
+    supported = false;
+}
+
+bool IsOverlayShaderSupported(void)
+{
+    return supported;
+}
+
+void BeginOverlays(void)
+{
+    if (!supported) {
+        return;
+    }
+
+    // The antialiased edge needs a fixed number of pixels whatever the zoom
+    Matrix modelview = rlGetMatrixModelview();
+    float scale = sqrtf(modelview.m0 * modelview.m0 + modelview.m1 * modelview.m1);
+    margin = AA_PIXELS / (scale > 0.0f ? scale : 1.0f);
+
+    BeginShaderMode(shader);
+}
+
+void EndOverlays(void)
+{
+    if (supported) {
+        EndShaderMode();
+    }
+}
+
+void DrawOverlayCircle(Vector2 center, float radius, Color color)
+{
+    if (!supported) {
+        DrawCircleV(center, radius, color);
+        return;
+    }
+    push_shape(center, (Vector2) { radius, radius }, radius, 0.0f, color);
+}
+
+void DrawOverlayRing(Vector2 center, float radius, float lineThick, Color color)
+{
+    if (!supported) {
+        DrawRing(center, radius - lineThick, radius, 0.0f, 360.0f, 0, color);
+        return;
+    }
+    push_shape(center, (Vector2) { radius, radius }, radius, lineThick, color);
+}
+
+void DrawOverlayRectangleRounded(Rectangle rec, float cornerRadius, float lineThick, Color color)
+{
+    if (!supported) {
+        if (lineThick > 0.0f) {
+            // Lines are drawn outside of the rectangle there, shrink it so both paths cover the same pixels
+            rec = (Rectangle) { rec.x + lineThick, rec.y + lineThick, rec.width - 2 * lineThick, rec.height - 2 * lineThick };
+            cornerRadius -= lineThick;
+        }
+        float shortest = rec.width < rec.height ? rec.width : rec.height;
+        float roundness = shortest > 0.0f && cornerRadius > 0.0f ? 2 * cornerRadius / shortest : 0.0f;
+        if (lineThick > 0.0f) {
+            DrawRectangleRoundedLinesEx(rec, roundness, 0, lineThick, color);
+        } else {
+            DrawRectangleRounded(rec, roundness, 0, color);
+        }
+        return;
+    }
+    Vector2 center = { rec.x + rec.width / 2, rec.y + rec.height / 2 };
+    push_shape(center, (Vector2) { rec.width / 2, rec.height / 2 }, cornerRadius, lineThick, color);
+}
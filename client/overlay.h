@@ -0,0 +1,18 @@
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include "raylib.h"
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+void InitOverlays(void); // Load the signed distance shader
+void UnloadOverlays(void); // Unload the signed distance shader
+bool IsOverlayShaderSupported(void); // Check if overlays are evaluated by the shader (OpenGL 3.3+ and ES 3.0), otherwise they're tessellated
+void BeginOverlays(void); // Begin drawing overlays, everything until EndOverlays() goes in the same draw call
+void EndOverlays(void); // End drawing overlays and flush them
+void DrawOverlayCircle(Vector2 center, float radius, Color color); // Draw a filled circle
+void DrawOverlayRing(Vector2 center, float radius, float lineThick, Color color); // Draw a circle outline, lineThick grows inwards from radius
+void DrawOverlayRectangleRounded(Rectangle rec, float cornerRadius, float lineThick, Color color); // Draw a rounded rectangle outline, filled if lineThick <= 0
+
+#endif // OVERLAY_H
@@ -0,0 +1,201 @@
+#include "particles.h"
+#include <math.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PARTICLES_SSE
+#endif
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define THROTTLE_THRESHOLD (MAX_PARTICLES / 2) // Bursts start shrinking once the pool is this full
+#define MIN_SPEED_FRACTION 0.25f // Slowest particle of a burst, relative to its speed
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Structure of arrays, so the update streams through each field. Particles live in a ring: new ones are appended
+// after the newest and the oldest are dropped once dead. Particles dying out of order stay in the ring as holes,
+// until a burst needs their room and the ring is compacted
+typedef struct ParticlePool {
+    float x[MAX_PARTICLES]; // Center
+    float y[MAX_PARTICLES];
+    float vx[MAX_PARTICLES];
+    float vy[MAX_PARTICLES];
+    float size[MAX_PARTICLES];
+    float shrink[MAX_PARTICLES]; // Size lost every tick
+    float life[MAX_PARTICLES]; // Ticks left, dead at 0
+    unsigned char color[MAX_PARTICLES];
+    int first; // Oldest particle in the ring
+    int count; // Ring length, holes included
+    int alive; // Particles left alive, what the budget is counted against
+} ParticlePool;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static ParticlePool pool = { 0 };
+static ParticleStats stats = { 0 };
+static unsigned int randomState = 0x9E3779B9u;
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions (local)
+//------------------------------------------------------------------------------------
+
+// xorshift32 in [0, 1), cheaper than GetRandomValue() for thousands of particles
+static inline float random_unit(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState >> 8) * (1.0f / 16777216.0f);
+}
+
+// Returns how many particles died this tick. Lives are whole ticks, so a particle dies the tick its life reaches 0
+static int update_span(int begin, int end)
+{
+    int i = begin;
+    int died = 0;
+#if defined(PARTICLES_SSE)
+    const __m128 drag = _mm_set1_ps(PARTICLE_DRAG);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= end; i += 4) {
+        __m128 vx = _mm_loadu_ps(&pool.vx[i]);
+        __m128 vy = _mm_loadu_ps(&pool.vy[i]);
+        _mm_storeu_ps(&pool.x[i], _mm_add_ps(_mm_loadu_ps(&pool.x[i]), vx));
+        _mm_storeu_ps(&pool.y[i], _mm_add_ps(_mm_loadu_ps(&pool.y[i]), vy));
+        _mm_storeu_ps(&pool.vx[i], _mm_mul_ps(vx, drag));
+        _mm_storeu_ps(&pool.vy[i], _mm_mul_ps(vy, drag));
+        _mm_storeu_ps(&pool.size[i], _mm_sub_ps(_mm_loadu_ps(&pool.size[i]), _mm_loadu_ps(&pool.shrink[i])));
+        __m128 life = _mm_sub_ps(_mm_loadu_ps(&pool.life[i]), one);
+        _mm_storeu_ps(&pool.life[i], life);
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(life, zero));
+        died += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+    }
+#endif
+    for (; i < end; i++) {
+        pool.x[i] += pool.vx[i];
+        pool.y[i] += pool.vy[i];
+        pool.vx[i] *= PARTICLE_DRAG;
+        pool.vy[i] *= PARTICLE_DRAG;
+        pool.size[i] -= pool.shrink[i];
+        pool.life[i] -= 1.0f;
+        died += pool.life[i] == 0.0f;
+    }
+    return died;
+}
+
+// Move the live particles to the front of the ring, in order, so the holes left between them can be reused
+static void compact_ring(void)
+{
+    int kept = 0;
+    for (int k = 0; k < pool.count; k++) {
+        int from = (pool.first + k) % MAX_PARTICLES;
+        if (pool.life[from] <= 0.0f) {
+            continue;
+        }
+        int to = (pool.first + kept++) % MAX_PARTICLES;
+        if (to != from) {
+            pool.x[to] = pool.x[from];
+            pool.y[to] = pool.y[from];
+            pool.vx[to] = pool.vx[from];
+            pool.vy[to] = pool.vy[from];
+            pool.size[to] = pool.size[from];
+            pool.shrink[to] = pool.shrink[from];
+            pool.life[to] = pool.life[from];
+            pool.color[to] = pool.color[from];
+        }
+    }
+    pool.count = kept;
+}
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+void ResetParticles(void)
+{
+    pool.first = 0;
+    pool.count = 0;
+    pool.alive = 0;
+    stats = (ParticleStats) { 0 };
+}
+
+int EmitParticles(ParticleBurst burst)
+{
+    if (burst.count <= 0 || burst.life <= 0) {
+        return 0;
+    }
+
+    // Past the threshold bursts shrink with the room left, so a flood of hits can't starve everything after it
+    int count = burst.count;
+    int room = MAX_PARTICLES - pool.alive;
+    if (pool.alive > THROTTLE_THRESHOLD) {
+        count = count * room / (MAX_PARTICLES - THROTTLE_THRESHOLD);
+    }
+    if (count > room) {
+        count = room;
+    }
+    if (pool.count + count > MAX_PARTICLES) {
+        compact_ring();
+    }
+    pool.alive += count;
+    stats.throttled += burst.count - count;
+    stats.emitted += count;
+
+    for (int k = 0; k < count; k++) {
+        int i = (pool.first + pool.count++) % MAX_PARTICLES;
+        float angle = random_unit() * 2.0f * PI;
+        float speed = burst.speed * (MIN_SPEED_FRACTION + (1.0f - MIN_SPEED_FRACTION) * random_unit());
+        pool.x[i] = burst.position.x;
+        pool.y[i] = burst.position.y;
+        pool.vx[i] = cosf(angle) * speed;
+        pool.vy[i] = sinf(angle) * speed;
+        pool.size[i] = burst.size;
+        pool.shrink[i] = burst.size / burst.life;
+        pool.life[i] = burst.life;
+        pool.color[i] = burst.color;
+    }
+    return count;
+}
+
+void UpdateParticles(void)
+{
+    // The ring is at most two contiguous spans
+    int end = pool.first + pool.count;
+    pool.alive -= update_span(pool.first, end < MAX_PARTICLES ? end : MAX_PARTICLES);
+    if (end > MAX_PARTICLES) {
+        pool.alive -= update_span(0, end - MAX_PARTICLES);
+    }
+
+    while (pool.count > 0 && pool.life[pool.first] <= 0.0f) {
+        pool.first = (pool.first + 1) % MAX_PARTICLES;
+        pool.count--;
+    }
+}
+
+int PackParticles(RectInstance *instances, int max, Rectangle bounds)
+{
+    int packed = 0;
+    for (int k = 0; k < pool.count; k++) {
+        int i = (pool.first + k) % MAX_PARTICLES;
+        if (pool.life[i] <= 0.0f) {
+            continue;
+        }
+        if (packed == max || pool.x[i] < bounds.x || pool.y[i] < bounds.y || pool.x[i] >= bounds.x + bounds.width || pool.y[i] >= bounds.y + bounds.height) {
+            continue;
+        }
+        float size = pool.size[i];
+        instances[packed++] = (RectInstance) { pool.x[i] - size / 2, pool.y[i] - size / 2, size, pool.color[i] };
+    }
+    stats.alive = pool.alive;
+    return packed;
+}
+
+ParticleStats GetParticleStats(void)
+{
+    return stats;
+}
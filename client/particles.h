@@ -0,0 +1,43 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "instancing.h"
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MAX_PARTICLES 16384 // Hard budget, shared by every burst
+#define PARTICLE_DRAG 0.9f // Velocity kept every tick
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Particles thrown out of a point in random directions, all at once
+typedef struct ParticleBurst {
+    Vector2 position;
+    int count;
+    float speed; // Fastest initial speed, in pixels per tick
+    float size; // Initial size, particles shrink to nothing over their life
+    int life; // In ticks
+    int color; // Index into the instance palette
+} ParticleBurst;
+
+// Counters since the last ResetParticles()
+typedef struct ParticleStats {
+    int alive; // As of the last PackParticles()
+    int emitted;
+    int throttled; // Particles bursts asked for but didn't get because of the budget
+} ParticleStats;
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+void ResetParticles(void); // Kill every particle and reset the counters
+int EmitParticles(ParticleBurst burst); // Emit a burst, shrunk as the pool fills up. Returns the particles actually emitted
+void UpdateParticles(void); // Advance every particle by one tick
+int PackParticles(RectInstance *instances, int max, Rectangle bounds); // Write the particles inside bounds as instances, returns how many
+ParticleStats GetParticleStats(void); // Get the particle counters
+
+#endif // PARTICLES_H
@@ -0,0 +1,403 @@
+#include "profiler.h"
+
+#if defined(PROFILER)
+#include "rlgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <pthread.h>
+#include <time.h>
+#define PROFILER_CLOCK_GETTIME
+#define PROFILER_TRACE // Traces are written by a background thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define BAR_HEIGHT 60 // Pixels of the tallest bar
+#define BAR_MS 33.3f // Frame time drawn at the top of the bars, longer frames are clipped
+#define BUDGET_MS (1000.0f / 60.0f) // Frame budget line
+#define LINE_HEIGHT 12
+#define FONT_SIZE 10
+#define TRACE_WRITE_INTERVAL_NS 10000000 // The writer drains every thread this often
+#define TRACE_PID 1
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Nanoseconds spent in each phase during one frame
+typedef struct ProfileFrame {
+    unsigned long long zones[PROFILE_PHASE_COUNT];
+    unsigned long long total; // From this frame's BeginProfileFrame() to the next one
+} ProfileFrame;
+
+// Milliseconds over the history
+typedef struct ProfileSummary {
+    float min;
+    float avg;
+    float p99;
+} ProfileSummary;
+
+#if defined(PROFILER_TRACE)
+typedef struct TraceEvent {
+    unsigned long long start;
+    unsigned long long end;
+    ProfileZone zone;
+} TraceEvent;
+
+// Events of one thread in a single producer, single consumer ring: the thread only moves head, the writer only moves tail
+typedef struct ProfileThread {
+    TraceEvent events[PROFILE_THREAD_EVENTS];
+    unsigned int head;
+    unsigned int tail;
+    unsigned int dropped; // Events lost because the ring was full
+    bool named; // Set once name is written, the thread can be picked up by the writer
+    char name[32];
+} ProfileThread;
+#endif
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static const char *zone_names[PROFILE_ZONE_COUNT] = {
+    [PROFILE_INPUT] = "INPUT",
+    [PROFILE_SIM_TASKS] = "TASKS",
+    [PROFILE_SIM_LANES] = "LANES",
+    [PROFILE_SIM_SYNC] = "SYNC",
+    [PROFILE_DRAW_LIST] = "DRAW",
+    [PROFILE_FLUSH] = "FLUSH",
+    [PROFILE_SWAP] = "SWAP",
+    [PROFILE_LANE] = "LANE",
+    [PROFILE_FRAME] = "FRAME",
+};
+
+static const Color zone_colors[PROFILE_PHASE_COUNT] = {
+    [PROFILE_INPUT] = SKYBLUE,
+    [PROFILE_SIM_TASKS] = LIME,
+    [PROFILE_SIM_LANES] = GREEN,
+    [PROFILE_SIM_SYNC] = DARKGREEN,
+    [PROFILE_DRAW_LIST] = ORANGE,
+    [PROFILE_FLUSH] = RED,
+    [PROFILE_SWAP] = PURPLE,
+};
+
+// Completed frames in a ring, the oldest is overwritten
+static ProfileFrame history[PROFILER_HISTORY] = { 0 };
+static int historyNext = 0;
+static int historyCount = 0;
+
+static ProfileFrame currentFrame = { 0 };
+static unsigned long long frameStart = 0;
+
+#if defined(PROFILER_TRACE)
+static ProfileThread threads[MAX_PROFILE_THREADS] = { 0 };
+static int threadCount = 0; // Slots handed out, may go past MAX_PROFILE_THREADS
+static __thread ProfileThread *localThread = NULL;
+
+static bool tracing = false;
+static bool traceStopping = false;
+static pthread_t traceWriter;
+static FILE *traceFile = NULL;
+static unsigned long long traceStart = 0;
+static bool traceThreadWritten[MAX_PROFILE_THREADS] = { 0 }; // Writer only
+static bool traceEventWritten = false; // Writer only, for the separators
+#endif
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions (local)
+//------------------------------------------------------------------------------------
+
+static inline const ProfileFrame *history_frame(int age)
+{
+    return &history[(historyNext - 1 - age + PROFILER_HISTORY) % PROFILER_HISTORY];
+}
+
+static int compare_floats(const void *a, const void *b)
+{
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+// Zone PROFILE_PHASE_COUNT is the whole frame
+static ProfileSummary summarize(int zone)
+{
+    static float samples[PROFILER_HISTORY];
+    ProfileSummary summary = { 0 };
+    if (historyCount == 0) {
+        return summary;
+    }
+
+    float sum = 0.0f;
+    for (int i = 0; i < historyCount; i++) {
+        const ProfileFrame *frame = history_frame(i);
+        samples[i] = (zone == PROFILE_PHASE_COUNT ? frame->total : frame->zones[zone]) / 1e6f;
+        sum += samples[i];
+    }
+    qsort(samples, historyCount, sizeof(float), compare_floats);
+
+    summary.min = samples[0];
+    summary.avg = sum / historyCount;
+    summary.p99 = samples[historyCount * 99 / 100];
+    return summary;
+}
+
+static void draw_summary_line(int x, int y, const char *name, Color color, ProfileSummary summary)
+{
+    DrawRectangle(x, y + 2, 6, 6, color);
+    DrawText(name, x + 10, y, FONT_SIZE, RAYWHITE);
+    DrawText(TextFormat("%.2f", summary.min), x + 70, y, FONT_SIZE, RAYWHITE);
+    DrawText(TextFormat("%.2f", summary.avg), x + 130, y, FONT_SIZE, RAYWHITE);
+    DrawText(TextFormat("%.2f", summary.p99), x + 190, y, FONT_SIZE, RAYWHITE);
+}
+
+#if defined(PROFILER_TRACE)
+static void push_trace_event(ProfileZone zone, unsigned long long start, unsigned long long end)
+{
+    ProfileThread *thread = localThread;
+    if (thread == NULL || !__atomic_load_n(&tracing, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    unsigned int head = thread->head;
+    if (head - __atomic_load_n(&thread->tail, __ATOMIC_ACQUIRE) == PROFILE_THREAD_EVENTS) {
+        __atomic_fetch_add(&thread->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    thread->events[head & (PROFILE_THREAD_EVENTS - 1)] = (TraceEvent) { start, end, zone };
+    __atomic_store_n(&thread->head, head + 1, __ATOMIC_RELEASE);
+}
+
+static void write_trace_separator(void)
+{
+    if (traceEventWritten) {
+        fputs(",\n", traceFile);
+    }
+    traceEventWritten = true;
+}
+
+// Write every event pushed so far, naming the threads seen for the first time
+static void write_trace_events(void)
+{
+    int count = __atomic_load_n(&threadCount, __ATOMIC_ACQUIRE);
+    if (count > MAX_PROFILE_THREADS) {
+        count = MAX_PROFILE_THREADS;
+    }
+
+    for (int i = 0; i < count; i++) {
+        ProfileThread *thread = &threads[i];
+        if (!__atomic_load_n(&thread->named, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        if (!traceThreadWritten[i]) {
+            write_trace_separator();
+            fprintf(traceFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", TRACE_PID, i + 1, thread->name);
+            traceThreadWritten[i] = true;
+        }
+
+        unsigned int head = __atomic_load_n(&thread->head, __ATOMIC_ACQUIRE);
+        unsigned int tail = thread->tail;
+        for (; tail != head; tail++) {
+            const TraceEvent *event = &thread->events[tail & (PROFILE_THREAD_EVENTS - 1)];
+            // Events that started before the trace did are from the previous one
+            if (event->start >= traceStart) {
+                write_trace_separator();
+                fprintf(traceFile, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", zone_names[event->zone], TRACE_PID, i + 1,
+                    (event->start - traceStart) / 1000.0, (event->end - event->start) / 1000.0);
+            }
+        }
+        __atomic_store_n(&thread->tail, tail, __ATOMIC_RELEASE);
+    }
+}
+
+static void *trace_writer(void *arg)
+{
+    (void)arg;
+    struct timespec interval = { 0, TRACE_WRITE_INTERVAL_NS };
+    while (!__atomic_load_n(&traceStopping, __ATOMIC_ACQUIRE)) {
+        write_trace_events();
+        nanosleep(&interval, NULL);
+    }
+    write_trace_events();
+    return NULL;
+}
+#endif
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+// clock_gettime() goes through the vDSO, which reads the TSC itself and already knows its frequency
+unsigned long long ProfileNow(void)
+{
+#if defined(PROFILER_CLOCK_GETTIME)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ull + now.tv_nsec;
+#else
+    return (unsigned long long)(GetTime() * 1e9);
+#endif
+}
+
+void EndProfileZone(ProfileZone zone, unsigned long long start)
+{
+    unsigned long long end = ProfileNow();
+    if (zone < PROFILE_PHASE_COUNT) {
+        currentFrame.zones[zone] += end - start;
+    }
+#if defined(PROFILER_TRACE)
+    push_trace_event(zone, start, end);
+#endif
+}
+
+void BeginProfileFrame(void)
+{
+    unsigned long long now = ProfileNow();
+    if (frameStart != 0) {
+        EndProfileZone(PROFILE_FRAME, frameStart);
+        currentFrame.total = now - frameStart;
+        history[historyNext] = currentFrame;
+        historyNext = (historyNext + 1) % PROFILER_HISTORY;
+        if (historyCount < PROFILER_HISTORY) {
+            historyCount++;
+        }
+    }
+    currentFrame = (ProfileFrame) { 0 };
+    frameStart = now;
+}
+
+void DrawProfilerOverlay(int x, int y)
+{
+    DrawRectangle(x, y, PROFILER_OVERLAY_WIDTH, PROFILER_OVERLAY_HEIGHT, Fade(BLACK, 0.6f));
+
+    // One bar per frame, newest on the right. Time outside of any zone is stacked on top in gray
+    float scale = BAR_HEIGHT / (BAR_MS * 1e6f);
+    float bottom = y + BAR_HEIGHT;
+    rlBegin(RL_QUADS);
+    for (int i = 0; i < historyCount; i++) {
+        const ProfileFrame *frame = history_frame(i);
+        float bar_x = x + PROFILER_OVERLAY_WIDTH - 1 - i;
+        float top = bottom;
+        unsigned long long zoned = 0;
+        for (int z = 0; z <= PROFILE_PHASE_COUNT && top > y; z++) {
+            unsigned long long ns;
+            Color color;
+            if (z < PROFILE_PHASE_COUNT) {
+                ns = frame->zones[z];
+                zoned += ns;
+                color = zone_colors[z];
+            } else {
+                ns = frame->total > zoned ? frame->total - zoned : 0;
+                color = GRAY;
+            }
+            float height = ns * scale;
+            if (top - height < y) {
+                height = top - y;
+            }
+            rlColor4ub(color.r, color.g, color.b, color.a);
+            rlRectangle2f(bar_x, top - height, 1.0f, height, 0.0f, 0.0f, 1.0f, 1.0f);
+            top -= height;
+        }
+    }
+    rlEnd();
+
+    int budget_y = bottom - BUDGET_MS * 1e6f * scale;
+    DrawLine(x, budget_y, x + PROFILER_OVERLAY_WIDTH, budget_y, Fade(RAYWHITE, 0.5f));
+
+    int line_y = y + BAR_HEIGHT + 2;
+    DrawText("ms", x + 10, line_y, FONT_SIZE, GRAY);
+    DrawText("min", x + 70, line_y, FONT_SIZE, GRAY);
+    DrawText("avg", x + 130, line_y, FONT_SIZE, GRAY);
+    DrawText("p99", x + 190, line_y, FONT_SIZE, GRAY);
+    for (int z = 0; z < PROFILE_PHASE_COUNT; z++) {
+        line_y += LINE_HEIGHT;
+        draw_summary_line(x, line_y, zone_names[z], zone_colors[z], summarize(z));
+    }
+    draw_summary_line(x, line_y + LINE_HEIGHT, zone_names[PROFILE_FRAME], GRAY, summarize(PROFILE_PHASE_COUNT));
+}
+
+void SetProfileThreadName(const char *name)
+{
+#if defined(PROFILER_TRACE)
+    if (localThread != NULL) {
+        return;
+    }
+    int index = __atomic_fetch_add(&threadCount, 1, __ATOMIC_ACQ_REL);
+    if (index >= MAX_PROFILE_THREADS) {
+        TraceLog(LOG_WARNING, "PROFILER: [%s] Too many threads, not traced", name);
+        return;
+    }
+    ProfileThread *thread = &threads[index];
+    snprintf(thread->name, sizeof(thread->name), "%s", name);
+    __atomic_store_n(&thread->named, true, __ATOMIC_RELEASE);
+    localThread = thread;
+#endif
+}
+
+bool StartProfileTrace(const char *fileName)
+{
+#if defined(PROFILER_TRACE)
+    if (traceFile != NULL) {
+        return false;
+    }
+    traceFile = fopen(fileName, "w");
+    if (traceFile == NULL) {
+        TraceLog(LOG_WARNING, "PROFILER: [%s] Failed to open trace file", fileName);
+        return false;
+    }
+
+    for (int i = 0; i < MAX_PROFILE_THREADS; i++) {
+        traceThreadWritten[i] = false;
+        __atomic_store_n(&threads[i].dropped, 0, __ATOMIC_RELAXED);
+    }
+    traceEventWritten = false;
+    traceStart = ProfileNow();
+    traceStopping = false;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", traceFile);
+    write_trace_separator();
+    fprintf(traceFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"Snowymaul TD\"}}", TRACE_PID);
+
+    if (pthread_create(&traceWriter, NULL, trace_writer, NULL) != 0) {
+        TraceLog(LOG_WARNING, "PROFILER: [%s] Failed to start trace writer", fileName);
+        fclose(traceFile);
+        traceFile = NULL;
+        return false;
+    }
+    __atomic_store_n(&tracing, true, __ATOMIC_RELEASE);
+    TraceLog(LOG_INFO, "PROFILER: [%s] Trace started", fileName);
+    return true;
+#else
+    TraceLog(LOG_WARNING, "PROFILER: Traces are not supported on this platform");
+    return false;
+#endif
+}
+
+void StopProfileTrace(void)
+{
+#if defined(PROFILER_TRACE)
+    if (traceFile == NULL) {
+        return;
+    }
+    __atomic_store_n(&tracing, false, __ATOMIC_RELEASE);
+    __atomic_store_n(&traceStopping, true, __ATOMIC_RELEASE);
+    pthread_join(traceWriter, NULL);
+
+    fputs("\n]}\n", traceFile);
+    fclose(traceFile);
+    traceFile = NULL;
+
+    unsigned int dropped = 0;
+    for (int i = 0; i < MAX_PROFILE_THREADS; i++) {
+        dropped += __atomic_load_n(&threads[i].dropped, __ATOMIC_RELAXED);
+    }
+    if (dropped > 0) {
+        TraceLog(LOG_WARNING, "PROFILER: Trace stopped, %u events dropped because the writer fell behind", dropped);
+    } else {
+        TraceLog(LOG_INFO, "PROFILER: Trace stopped");
+    }
+#endif
+}
+
+#endif // PROFILER
@@ -0,0 +1,58 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define PROFILER_HISTORY 256 // Frames kept for the overlay, a bit over 4 seconds at 60 FPS
+#define PROFILER_OVERLAY_WIDTH PROFILER_HISTORY // One pixel per frame
+#define PROFILER_OVERLAY_HEIGHT (60 + 12 * (PROFILE_PHASE_COUNT + 2)) // Bars, then a line per phase, the frame and the header
+#define MAX_PROFILE_THREADS 16 // Threads that can record trace events
+#define PROFILE_THREAD_EVENTS 4096 // Trace events a thread can have waiting for the writer, must be a power of two
+
+// Zones compile to nothing unless PROFILER is defined. A zone is closed in the scope it was opened in,
+// time spent in the same zone several times in a frame adds up
+#if defined(PROFILER)
+#define PROFILE_BEGIN(zone) unsigned long long profile_start_##zone = ProfileNow()
+#define PROFILE_END(zone) EndProfileZone(zone, profile_start_##zone)
+#else
+#define PROFILE_BEGIN(zone)
+#define PROFILE_END(zone)
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Phases of a frame, stacked in this order in the overlay, followed by zones that are only traced
+typedef enum ProfileZone {
+    PROFILE_INPUT, // Player input and camera
+    PROFILE_SIM_TASKS, // Spawn timeline and scheduled tasks
+    PROFILE_SIM_LANES, // Lane updates, on the workers when threaded
+    PROFILE_SIM_SYNC, // Lane exchanges and effects
+    PROFILE_DRAW_LIST, // World and HUD draws, recorded and submitted to rlgl
+    PROFILE_FLUSH, // Last render batch draw of the frame
+    PROFILE_SWAP, // EndDrawing(): buffer swap, frame wait and event polling
+    PROFILE_LANE, // One lane update, on whichever thread picked it up
+    PROFILE_FRAME, // Whole frame, recorded by BeginProfileFrame()
+    PROFILE_ZONE_COUNT
+} ProfileZone;
+
+#define PROFILE_PHASE_COUNT (PROFILE_SWAP + 1)
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+// Phases are only recorded on the main thread. Any thread that named itself records trace events while a trace is running
+unsigned long long ProfileNow(void); // Get a monotonic timestamp, in nanoseconds
+void EndProfileZone(ProfileZone zone, unsigned long long start); // Add the time since start to a phase of the current frame, and trace it
+void BeginProfileFrame(void); // Store the current frame in the history and start the next one
+void DrawProfilerOverlay(int x, int y); // Draw stacked phase bars of the history and min/avg/p99 of every phase
+
+void SetProfileThreadName(const char *name); // Name the calling thread in traces, it records trace events from now on
+bool StartProfileTrace(const char *fileName); // Start streaming trace events to a Chrome/Perfetto trace-event JSON file
+void StopProfileTrace(void); // Write the remaining events and close the trace file
+
+#endif // PROFILER_H
@@ -1,11 +1,28 @@
+#include "atlas.h"
+#include "damagenumbers.h"
+#include "drawlist.h"
+#include "instancing.h"
+#include "overlay.h"
+#include "particles.h"
+#include "profiler.h"
+#include "textlayout.h"
+#include "tilemap.h"
 #include "raylib.h"
 #include "raymath.h"
+#include "rlgl.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if defined(PLATFORM_WEB)
 #include <emscripten/emscripten.h>
 #endif
 
+#if defined(SIM_THREADS)
+#include <pthread.h>
+#include <stdint.h>
+#endif
+
 #ifdef __GNUC__ // GCC, Clang, ICC
 #define UNREACHABLE() (__builtin_unreachable())
 #endif
@@ -23,28 +40,117 @@
 #define SCREEN_WIDTH 800
 #define SCREEN_HEIGHT 450
 #define SQUARE_SIZE 32
-#define SLOTS_X SCREEN_WIDTH / SQUARE_SIZE
-#define SLOTS_Y SCREEN_HEIGHT / SQUARE_SIZE
+#define TICKS_PER_SECOND 60
+#define SLOTS_X (SCREEN_WIDTH / SQUARE_SIZE)
+#define SLOTS_Y (SCREEN_HEIGHT / SQUARE_SIZE)
 
 // Rendering stuff
 #define BORDER_THICKNESS 2
+
+// Camera
+#define MIN_CAMERA_ZOOM 0.5f
+#define MAX_CAMERA_ZOOM 4.0f
+#define CAMERA_ZOOM_STEP 0.125f // Relative zoom change per wheel notch or key press
+#define CULL_MARGIN_SLOTS 1 // Minions are indexed by their center, so look one slot past the edges of the view
 #define CURSOR_COLOR GOLD
 
-// Entity constants
+// Crowd level of detail
+#define LOD_MAX_ZOOM 1.0f // Crowds are only aggregated while zoomed out below this
+#define LOD_CROWD_SIZE 8 // Minions in a slot before it turns into a heat tile at zoom 1, scaled down with the zoom
+#define LOD_FULL_DENSITY 32 // Minions in a slot for a fully opaque heat tile
+#define LOD_HEALTHY_COLOR MAROON
+#define LOD_WOUNDED_COLOR ORANGE
+
+// Overlays
+#define RANGE_RING_THICKNESS 2
+#define RANGE_FILL_ALPHA 0.08f // Ranges are tinted discs under the ring, faint enough to overlap by the hundred
+#define CURSOR_CORNER_RADIUS 6
+
+// Lanes
+#define TEAM_COUNT 2
+#define LANES_PER_TEAM 4
+#define LANE_COUNT (TEAM_COUNT * LANES_PER_TEAM)
+#define LANE_WIDTH 3 // In slots, every lane spans the full height of the board
+#define LANE_CELLS (LANE_WIDTH * SLOTS_Y)
+#define TEAM_GAP 1 // Empty columns between the lanes of each team
+#define TEAM_LIVES 20
+#define LOCAL_TEAM 0
+#define PLAYER_COUNT LANE_COUNT // Every player owns exactly one lane
+#define LOCAL_PLAYER 0
+#define SIM_WORKER_COUNT 3 // Lanes are also updated on the main thread
+
+// Entity constants (per lane)
 #define MAX_TOWERS 100
-#define MAX_MINIONS 100
+#define MAX_MINIONS 512
 #define MAX_PROJECTILES 5000
+#define MAX_HITS 8192 // Hits collected in a single tick before being resolved
+#define MAX_LANE_LEAKS MAX_MINIONS
 #define STARTING_MINION_WAVE_SIZE 5
 #define TOWER_COST 10
 #define STARTING_GOLD 100
 
+// Economy
+#define STARTING_INCOME 5
+#define INCOME_INTERVAL 600 // Ticks between income payouts
+#define SEND_FLUSH_INTERVAL 60 // Ticks between turning queued sends into spawn groups
+#define SEND_GROUP_SPACING 16.0f // Distance between minions of a spawn group as they walk in
+
 // Towers
 #define DEFAULT_TOWER_HEALTH 100
 #define DEFAULT_TOWER_POWER 10
+#define DEFAULT_TOWER_RANGE 96.0f
+#define DEFAULT_TOWER_COOLDOWN 30 // In ticks
 #define DEFAULT_TOWER_COLOR SKYBLUE
+#define MAX_TOWER_LEVEL 3
+#define TOWER_SELL_REFUND_PERCENT 75
+
+// Minions
+#define DEFAULT_MINION_HEALTH 60
+#define DEFAULT_MINION_SPEED 1.0f
+#define DEFAULT_MINION_SIZE 12
+#define DEFAULT_MINION_COLOR MAROON
+#define DEFAULT_MINION_BOUNTY 1
+#define INDEX_NONE 0xFFFF // Minion index entry of a minion that died after the index was built
+
+// Waves
+#define MAX_SPAWN_EVENTS 4096
+#define ALL_LANES ((1u << LANE_COUNT) - 1)
+
+// Projectiles
+#define PROJECTILE_SIZE 4
+#define PROJECTILE_IMPACT_RADIUS 12.0f
+#define DEFAULT_PROJECTILE_COLOR BLACK
+
+// Effects
+#define MAX_LANE_EFFECTS 2048 // Effects produced by a lane in a single tick
+#define HIT_PARTICLE_COLOR YELLOW
+#define DAMAGE_NUMBER_COLOR DARKGRAY
+
+// Instanced rendering
+#define MAX_RECT_INSTANCES (LANE_COUNT * (MAX_MINIONS + MAX_PROJECTILES) + MAX_PARTICLES)
+#define PROJECTILE_PALETTE_INDEX MINION_KIND_COUNT // Minions and their death particles use their MinionKind as palette index
+#define MUZZLE_PALETTE_INDEX (PROJECTILE_PALETTE_INDEX + 1) // One per TowerKind
+#define HIT_PALETTE_INDEX (MUZZLE_PALETTE_INDEX + TOWER_KIND_COUNT)
 
 // Paths
 #define DEFAULT_PATH_COLOR DARKBLUE
+#define PATH_DIST_UNREACHABLE 0xFFFF
+#define BLOCKED_CELL_COLOR LIGHTGRAY
+#define GRID_COLOR LIGHTGRAY
+
+// Headless runs (PLATFORM=Memory, software renderer)
+#define HEADLESS_FRAMES 600 // Ten seconds of game, enough for the first waves to reach the towers
+#define HEADLESS_SCREENSHOT "headless.png" // Last frame, for inspection or diffing in CI
+#define TRACE_FILE_ENV "TD_TRACE" // Environment variable naming the trace file of a profiled build
+
+// Sprites
+#define ATLAS_WIDTH 128
+#define HUD_ICON_SIZE 20
+#define DIGIT_FONT_SIZE 10 // Damage number digits are baked at the default font's size
+
+// Tilemap palette, towers use their TowerKind as palette index
+#define PATH_TILE_COLOR TOWER_KIND_COUNT
+#define BLOCKED_TILE_COLOR (TOWER_KIND_COUNT + 1)
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
@@ -55,11 +161,81 @@ typedef enum DrawStyle {
     BORDER_ONLY,
 } DrawStyle;
 
+// Draw list layers, on top of the board, the instanced entities and the overlays
+typedef enum DrawLayer {
+    DRAW_LAYER_HUD = 0,
+} DrawLayer;
+
+typedef enum ProjectileKind {
+    PROJECTILE_BULLET, // Travels to the aim point and hits the closest minion there
+    PROJECTILE_INSTANT, // Hits on the tick it is fired, never allocates a Bullet
+    PROJECTILE_SPLASH, // Hits every minion within splash_radius of the impact point
+    PROJECTILE_CHAIN, // Hits the closest minion, then bounces to nearby minions
+} ProjectileKind;
+
+typedef enum TowerKind {
+    TOWER_BASIC,
+    TOWER_SNIPER,
+    TOWER_CANNON,
+    TOWER_TESLA,
+    TOWER_KIND_COUNT,
+} TowerKind;
+
+typedef enum MinionKind {
+    MINION_GRUNT,
+    MINION_RUNNER,
+    MINION_BRUTE,
+    MINION_KIND_COUNT,
+} MinionKind;
+
+// Sprites are added to the atlas in this order, so each value is also the sprite's index in the atlas.
+// Minions and bullets are instanced squares colored from the instance palette, they have no sprite
+typedef enum Sprite {
+    SPRITE_TOWER = 0, // One per TowerKind
+    SPRITE_GOLD = SPRITE_TOWER + TOWER_KIND_COUNT,
+    SPRITE_LIVES,
+    SPRITE_DIGITS, // 0 to 9 in equal-width cells
+    SPRITE_COUNT,
+} Sprite;
+
+typedef struct MinionArchetype {
+    const char *name;
+    int health;
+    float speed;
+    int size;
+    int bounty;
+    int send_cost;
+    int send_income; // Income gained by the sender
+    Color color;
+} MinionArchetype;
+
+typedef struct TowerDef {
+    const char *name;
+    int cost;
+    int power;
+    float range;
+    int cooldown;
+    ProjectileKind projectile;
+    float projectile_speed;
+    float splash_radius;
+    int chain_bounces;
+    float chain_radius;
+    Color color;
+} TowerDef;
+
 typedef struct SlotVector2 {
     unsigned int x;
     unsigned int y;
 } SlotVector2;
 
+// Inclusive range of slots
+typedef struct SlotRect {
+    int min_x;
+    int min_y;
+    int max_x;
+    int max_y;
+} SlotRect;
+
 typedef struct Cursor {
     Vector2 position;
     Vector2 size;
@@ -67,6 +243,18 @@ typedef struct Cursor {
     DrawStyle style;
 } Cursor;
 
+typedef enum CellKind {
+    CELL_EMPTY,
+    CELL_PATH,
+    CELL_TOWER,
+} CellKind;
+
+// What occupies a slot. For towers, `tower` is the index into the towers of the lane containing the slot
+typedef struct Cell {
+    CellKind kind;
+    unsigned short tower;
+} Cell;
+
 typedef struct Path {
     bool alive;
     SlotVector2 slot_pos;
@@ -75,6 +263,10 @@ typedef struct Path {
 
 typedef struct Tower {
     bool alive;
+    TowerKind kind;
+    int level;
+    int invested; // Gold spent on building and upgrading, used for refunds
+    int cooldown;
     SlotVector2 slot_pos;
     Vector2 size;
     int max_health;
@@ -84,6 +276,8 @@ typedef struct Tower {
 
 typedef struct Bullet {
     bool alive;
+    TowerKind source;
+    int ttl; // Ticks left until impact
     Vector2 position;
     Vector2 size;
     int base_power;
@@ -93,25 +287,105 @@ typedef struct Bullet {
 
 typedef struct Minion {
     bool alive;
+    MinionKind kind;
     Vector2 position;
     Vector2 size;
     int max_health;
     int curr_health;
+    float speed;
+    SlotVector2 target_slot;
     Vector2 velocity;
     Color color;
 } Minion;
 
-//----------------------------------------------------------------------------------
-// Macros
-//----------------------------------------------------------------------------------
-
-#define INIT_PATHS(type, create_path, ...)                      \
-    do {                                                        \
-        type temp[] = { __VA_ARGS__ };                          \
-        for (int i = 0; i < sizeof(temp) / sizeof(type); i++) { \
-            create_path(temp[i]);                               \
-        }                                                       \
-    } while (0)
+typedef enum EffectKind {
+    EFFECT_MUZZLE, // A tower fired
+    EFFECT_HIT, // A minion took damage
+    EFFECT_DEATH, // A minion died
+} EffectKind;
+
+// Something worth showing that happened during a tick, turned into particles on the main thread once every lane is done
+typedef struct Effect {
+    EffectKind kind;
+    int variant; // TowerKind of muzzle flashes, MinionKind of hits and deaths
+    int damage; // Of hits and deaths
+    Vector2 position;
+} Effect;
+
+// A single damage event, resolved at the end of the tick it was produced in
+typedef struct Hit {
+    unsigned short minion;
+    int damage;
+} Hit;
+
+// A lane is a sim partition: it owns every tower, minion and bullet inside its strip of the board.
+// Lanes only read shared map data while updating, and exchange leaked minions in sync_lanes()
+typedef struct Lane {
+    int index;
+    int team;
+    int owner; // Player building in this lane and earning its bounties
+    int opponent_lane; // Lane that receives the owner's sends
+    int next_lane; // Lane that catches minions leaking out of this one, -1 if leaks cost a life
+    SlotVector2 origin; // Top left slot of the lane strip
+    SlotVector2 spawn_slot;
+
+    Tower towers[MAX_TOWERS];
+    int tower_count;
+    Minion minions[MAX_MINIONS];
+    int minion_count;
+    Bullet bullets[MAX_PROJECTILES];
+    int bullet_count;
+    Hit hits[MAX_HITS];
+    int hit_count;
+
+    // Minion index: minions bucketed per slot of the strip, rebuilt every tick (cell_start is a prefix sum)
+    unsigned short cell_start[LANE_CELLS + 1];
+    unsigned short cell_items[MAX_MINIONS];
+    unsigned short minion_cells[MAX_MINIONS];
+    int indexed_count; // Minions the index still covers after the tick, handoffs are appended past it
+
+    // Output of the tick, consumed by sync_lanes()
+    Minion leaks[MAX_LANE_LEAKS];
+    int leak_count;
+    int bounty;
+    Effect effects[MAX_LANE_EFFECTS];
+    int effect_count;
+} Lane;
+
+// Sends are only counted per archetype when requested; they become spawn groups when the scheduler flushes them
+typedef struct SendQueue {
+    int pending[MINION_KIND_COUNT];
+} SendQueue;
+
+// One line of the wave definitions: `groups` bursts of `count` minions, `spacing` ticks apart, in every lane of `lanes`
+typedef struct WaveDef {
+    int start; // In ticks
+    MinionKind kind;
+    int groups;
+    int count;
+    int spacing; // In ticks
+    unsigned int lanes; // Bitmask of lanes
+} WaveDef;
+
+// A single burst of the compiled spawn timeline
+typedef struct SpawnEvent {
+    int tick;
+    unsigned char lane;
+    unsigned char kind;
+    unsigned short count;
+} SpawnEvent;
+
+// A HUD text, formatted and laid out again only when the values it shows change
+typedef struct HudLabel {
+    TextLayout layout;
+    int values[3];
+} HudLabel;
+
+// Periodic sim work, run from the serial part of the tick
+typedef struct SimTask {
+    int period; // In ticks
+    void (*run)(void);
+} SimTask;
 
 //------------------------------------------------------------------------------------
 // Global Variables Declaration
@@ -119,25 +393,131 @@ typedef struct Minion {
 static const int screenWidth = SCREEN_WIDTH;
 static const int screenHeight = SCREEN_HEIGHT;
 
+static const TowerDef tower_defs[TOWER_KIND_COUNT] = {
+    [TOWER_BASIC] = { "BASIC", TOWER_COST, DEFAULT_TOWER_POWER, DEFAULT_TOWER_RANGE, DEFAULT_TOWER_COOLDOWN, PROJECTILE_BULLET, 6.0f, 0.0f, 0, 0.0f, DEFAULT_TOWER_COLOR },
+    [TOWER_SNIPER] = { "SNIPER", TOWER_COST * 2, 25, 160.0f, 60, PROJECTILE_INSTANT, 0.0f, 0.0f, 0, 0.0f, PURPLE },
+    [TOWER_CANNON] = { "CANNON", TOWER_COST * 3, 15, 112.0f, 75, PROJECTILE_SPLASH, 4.0f, 40.0f, 0, 0.0f, ORANGE },
+    [TOWER_TESLA] = { "TESLA", TOWER_COST * 3, 12, 96.0f, 45, PROJECTILE_CHAIN, 8.0f, 0.0f, 3, 64.0f, LIME },
+};
+
+static const MinionArchetype minion_archetypes[MINION_KIND_COUNT] = {
+    [MINION_GRUNT] = { "GRUNT", DEFAULT_MINION_HEALTH, DEFAULT_MINION_SPEED, DEFAULT_MINION_SIZE, DEFAULT_MINION_BOUNTY, 5, 1, DEFAULT_MINION_COLOR },
+    [MINION_RUNNER] = { "RUNNER", 30, 2.0f, 10, DEFAULT_MINION_BOUNTY, 8, 1, RED },
+    [MINION_BRUTE] = { "BRUTE", 200, 0.6f, 16, 3, 20, 4, BROWN },
+};
+
+static const WaveDef wave_defs[] = {
+    { 0 * TICKS_PER_SECOND, MINION_GRUNT, STARTING_MINION_WAVE_SIZE, 1, TICKS_PER_SECOND / 2, ALL_LANES },
+    { 10 * TICKS_PER_SECOND, MINION_GRUNT, 4, 2, TICKS_PER_SECOND, ALL_LANES },
+    { 20 * TICKS_PER_SECOND, MINION_RUNNER, 6, 1, TICKS_PER_SECOND / 3, ALL_LANES },
+    { 30 * TICKS_PER_SECOND, MINION_GRUNT, 5, 3, TICKS_PER_SECOND, ALL_LANES },
+    { 32 * TICKS_PER_SECOND, MINION_RUNNER, 4, 2, TICKS_PER_SECOND, ALL_LANES },
+    { 45 * TICKS_PER_SECOND, MINION_BRUTE, 3, 1, 2 * TICKS_PER_SECOND, ALL_LANES },
+    { 60 * TICKS_PER_SECOND, MINION_GRUNT, 8, 4, TICKS_PER_SECOND / 2, ALL_LANES },
+    { 62 * TICKS_PER_SECOND, MINION_BRUTE, 4, 2, 2 * TICKS_PER_SECOND, ALL_LANES },
+    { 80 * TICKS_PER_SECOND, MINION_RUNNER, 10, 4, TICKS_PER_SECOND / 2, ALL_LANES },
+    { 100 * TICKS_PER_SECOND, MINION_BRUTE, 10, 3, TICKS_PER_SECOND, ALL_LANES },
+};
+
+// Particles of each effect, color is filled in from the effect's variant
+static const ParticleBurst effect_bursts[] = {
+    [EFFECT_MUZZLE] = { .count = 4, .speed = 1.5f, .size = 3.0f, .life = 8 },
+    [EFFECT_HIT] = { .count = 6, .speed = 2.0f, .size = 3.0f, .life = 12 },
+    [EFFECT_DEATH] = { .count = 24, .speed = 3.0f, .size = 5.0f, .life = 30 },
+};
+
+// Keys used by the local player to send each archetype
+static const int minion_send_keys[MINION_KIND_COUNT] = { KEY_Q, KEY_W, KEY_E };
+
+// Path of a single lane, relative to the lane origin. Minions spawn on the first slot and leak out of the bottom row
+static const SlotVector2 lane_path_template[] = {
+    { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 },
+    { 1, 3 }, { 2, 3 },
+    { 2, 4 }, { 2, 5 }, { 2, 6 }, { 2, 7 },
+    { 1, 7 }, { 0, 7 },
+    { 0, 8 }, { 0, 9 }, { 0, 10 },
+    { 1, 10 }, { 2, 10 },
+    { 2, 11 }, { 2, 12 }, { 2, 13 },
+};
+
 static int framesCounter = 0;
 static bool gameOver = false;
 static bool pause = false;
-static int gold = STARTING_GOLD;
-static unsigned int currentTowers = 0;
-static unsigned int currentBullets = 0;
-static unsigned int currentMinions = 0;
+// Economy is kept as parallel arrays so the scheduler can pay everyone in one pass
+static int player_gold[PLAYER_COUNT] = { 0 };
+static int player_income[PLAYER_COUNT] = { 0 };
+static SendQueue send_queues[PLAYER_COUNT] = { 0 };
+static int lives[TEAM_COUNT] = { 0 };
 static unsigned int currentPaths = 0;
 
-// TODO: Use a bitset for slots_occupied
-static bool slots_occupied[SLOTS_X][SLOTS_Y] = { 0 };
+// Wave definitions compiled into a flat timeline sorted by tick, consumed by a cursor as the game advances
+static SpawnEvent spawn_timeline[MAX_SPAWN_EVENTS] = { 0 };
+static int spawnTimelineLength = 0;
+static int spawnTimelineCursor = 0;
+static TowerKind selectedTower = TOWER_BASIC;
+
+static Cell cells[SLOTS_X][SLOTS_Y] = { 0 };
 static Path paths[SLOTS_X][SLOTS_Y] = { 0 };
 static Cursor cursor = { 0 };
-static Tower towers[MAX_TOWERS] = { 0 };
-static Bullet bullets[MAX_PROJECTILES] = { 0 };
-static Minion minions[MAX_MINIONS] = { 0 };
+static Lane lanes[LANE_COUNT] = { 0 };
+
+// Distance in slots from each path slot to its lane's exit, used as a flow field for minions
+static unsigned short path_dist[SLOTS_X][SLOTS_Y] = { 0 };
+
+#if defined(SIM_THREADS)
+static pthread_t simWorkers[SIM_WORKER_COUNT];
+static pthread_mutex_t simMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t simStartCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t simDoneCond = PTHREAD_COND_INITIALIZER;
+static unsigned int simGeneration = 0;
+static int simNextLane = 0;
+static int simLanesDone = 0;
+static bool simShutdown = false;
+static bool simWorkersStarted = false;
+#endif
 static bool allowMove = false;
+static bool showAllRanges = false;
+#ifdef PROFILER
+static bool showProfiler = false; // Toggled with F3, phases are recorded either way
+#endif
 static Vector2 offset = { 0 };
 
+// Grid lines, paths and towers only change with the map. With a tilemap shader the whole board is a single quad and
+// only changed cells are uploaded, otherwise the board is rendered into boardLayer whenever it changes. Without render
+// textures either (OpenGL 1.1, software renderer) it is drawn again every frame
+static Tilemap boardTilemap = { 0 };
+static RenderTexture2D boardLayer = { 0 };
+static bool boardDirty = true;
+static bool gpuResourcesLoaded = false; // GPU resources survive restarts
+
+// Minions and bullets of every lane, packed every frame and drawn with a single instanced draw call
+static RectInstance rectInstances[MAX_RECT_INSTANCES] = { 0 };
+
+// At zoom 1 the camera maps the board 1:1 onto the screen
+static Camera2D camera = { 0 };
+
+// Every sprite and the white texel shapes are drawn with, so the world layer never switches textures
+static Atlas spriteAtlas = { 0 };
+static Texture2D defaultShapesTexture = { 0 };
+static Rectangle defaultShapesRec = { 0 };
+
+static HudLabel goldLabel = { 0 };
+static HudLabel livesLabel = { 0 };
+static HudLabel towerLabel = { 0 };
+static HudLabel hoveredLabel = { 0 };
+static TextLayout pausedLayout = { 0 };
+static TextLayout gameOverLayout = { 0 };
+
+// One texel per slot, crowded slots are drawn as a single heat tile instead of their minions when zoomed out
+static Texture2D crowdHeat = { 0 };
+static Color crowdTexels[SLOTS_Y][SLOTS_X] = { 0 };
+static bool crowded[SLOTS_X][SLOTS_Y] = { 0 };
+
+#ifdef DEBUG
+// Render stats of the previous frame, the current one is still being drawn when the overlay is
+static rlRenderStats lastRenderStats = { 0 };
+#endif
+
 //------------------------------------------------------------------------------------
 // Module Functions Declaration (local)
 //------------------------------------------------------------------------------------
@@ -146,12 +526,15 @@ static void UpdateGame(void); // Update game (one frame)
 static void DrawGame(void); // Draw game (one frame)
 static void UnloadGame(void); // Unload game
 static void UpdateDrawFrame(void); // Update and Draw (one frame)
+static void UpdateSim(void); // Update simulation (one tick)
 
 // Cleanup
-static void run_defrag(void); // Run defrag on entity arrays
+static void run_defrag(Lane *lane); // Run defrag on entity arrays
 
 // Custom logic functions
 static bool maybe_purchase_tower(Cursor cursor); // Attempt to purchase tower
+static bool maybe_upgrade_tower(Cursor cursor); // Attempt to upgrade the tower under the cursor
+static bool maybe_sell_tower(Cursor cursor); // Sell the tower under the cursor
 
 //------------------------------------------------------------------------------------
 // Program main entry point
@@ -162,10 +545,28 @@ int main(void)
     //---------------------------------------------------------
     InitWindow(screenWidth, screenHeight, "Snowymaul TD");
 
+#ifdef PROFILER
+    // Set TD_TRACE to a file name to record a trace of the whole run, to be opened in Perfetto or chrome://tracing
+    SetProfileThreadName("main");
+    const char *trace_file = getenv(TRACE_FILE_ENV);
+    if (trace_file != NULL) {
+        StartProfileTrace(trace_file);
+    }
+#endif
+
     InitGame();
 
 #if defined(PLATFORM_WEB)
     emscripten_set_main_loop(UpdateDrawFrame, 60, 1);
+#elif defined(PLATFORM_MEMORY)
+    // No window and no frame limit: the game runs one tick per frame, so this is always the same game
+    double start = GetTime();
+    for (int frame = 0; frame < HEADLESS_FRAMES; frame++) {
+        UpdateDrawFrame();
+    }
+    double elapsed = GetTime() - start;
+    TraceLog(LOG_INFO, "HEADLESS: %d frames in %.3f s, %.3f ms per frame", HEADLESS_FRAMES, elapsed, elapsed * 1000.0 / HEADLESS_FRAMES);
+    TakeScreenshot(HEADLESS_SCREENSHOT);
 #else
     SetTargetFPS(60);
     //--------------------------------------------------------------------------------------
@@ -182,6 +583,9 @@ int main(void)
     // De-Initialization
     //--------------------------------------------------------------------------------------
     UnloadGame(); // Unload loaded data (textures, sounds, models...)
+#ifdef PROFILER
+    StopProfileTrace(); // After the workers are stopped, so their last events are in
+#endif
 
     CloseWindow(); // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
@@ -193,52 +597,52 @@ int main(void)
 // Module Functions Definitions (local)
 //------------------------------------------------------------------------------------
 
-void run_defrag()
+// Compact the live minions and bullets of a lane to the front of its arrays
+// The minion index is patched to the new indices, dead minions are left in it as INDEX_NONE
+void run_defrag(Lane *lane)
 {
+    unsigned short remap[MAX_MINIONS];
+    for (int k = 0; k < lane->minion_count; k++) {
+        remap[k] = lane->minions[k].alive ? k : INDEX_NONE;
+    }
+
     int i = 0;
-    int j = MAX_MINIONS - 1;
-    while (i < j) {
-        if (!minions[j].alive) {
+    int j = lane->minion_count - 1;
+    while (i <= j) {
+        if (!lane->minions[j].alive) {
             j--;
             continue;
         }
-        if (minions[i].alive) {
+        if (lane->minions[i].alive) {
             i++;
             continue;
         }
-        minions[i] = minions[j];
-        minions[j].alive = false;
+        lane->minions[i] = lane->minions[j];
+        lane->minions[j].alive = false;
+        remap[j] = i;
     }
+    lane->minion_count = i;
+    lane->indexed_count = i;
 
-    i = 0;
-    j = MAX_TOWERS - 1;
-    while (i < j) {
-        if (!towers[j].alive) {
-            j--;
-            continue;
-        }
-        if (towers[i].alive) {
-            i++;
-            continue;
-        }
-        towers[i] = towers[j];
-        towers[j].alive = false;
+    for (int k = 0; k < lane->cell_start[LANE_CELLS]; k++) {
+        lane->cell_items[k] = remap[lane->cell_items[k]];
     }
 
     i = 0;
-    j = MAX_PROJECTILES - 1;
-    while (i < j) {
-        if (!bullets[j].alive) {
+    j = lane->bullet_count - 1;
+    while (i <= j) {
+        if (!lane->bullets[j].alive) {
             j--;
             continue;
         }
-        if (bullets[i].alive) {
+        if (lane->bullets[i].alive) {
             i++;
             continue;
         }
-        bullets[i] = bullets[j];
-        bullets[j].alive = false;
+        lane->bullets[i] = lane->bullets[j];
+        lane->bullets[j].alive = false;
     }
+    lane->bullet_count = i;
 }
 
 static inline Rectangle pos_and_size_to_rect(Vector2 pos, Vector2 size)
@@ -266,9 +670,62 @@ static inline bool is_same_slot_pos(SlotVector2 pos1, SlotVector2 pos2)
     return pos1.x == pos2.x && pos1.y == pos2.y;
 }
 
+static inline bool is_slot_in_bounds(int x, int y)
+{
+    return x >= 0 && x < SLOTS_X && y >= 0 && y < SLOTS_Y;
+}
+
 static inline bool is_slot_occupied(SlotVector2 slot_pos)
 {
-    return slots_occupied[slot_pos.x][slot_pos.y];
+    return cells[slot_pos.x][slot_pos.y].kind != CELL_EMPTY;
+}
+
+// Returns the lane whose strip contains the slot, or -1 for the gap between the teams
+// NOTE: Computed from the column with the layout of create_lanes(): each team is its lanes followed by TEAM_GAP columns
+static inline int lane_of_slot(SlotVector2 slot_pos)
+{
+    unsigned int team = slot_pos.x / (LANES_PER_TEAM * LANE_WIDTH + TEAM_GAP);
+    unsigned int x = slot_pos.x % (LANES_PER_TEAM * LANE_WIDTH + TEAM_GAP);
+    if (team >= TEAM_COUNT || x >= LANES_PER_TEAM * LANE_WIDTH) {
+        return -1;
+    }
+    return team * LANES_PER_TEAM + x / LANE_WIDTH;
+}
+
+// Encode a cell the way the tilemap shader draws it
+static unsigned char get_cell_tile(SlotVector2 slot_pos)
+{
+    const Cell *cell = &cells[slot_pos.x][slot_pos.y];
+    switch (cell->kind) {
+    case CELL_PATH:
+        return TILEMAP_TILE(TILE_SHAPE_FILL, PATH_TILE_COLOR);
+    case CELL_TOWER:
+        return TILEMAP_TILE(TILE_SHAPE_FOOTPRINT, lanes[lane_of_slot(slot_pos)].towers[cell->tower].kind);
+    default:
+        return lane_of_slot(slot_pos) < 0 ? TILEMAP_TILE(TILE_SHAPE_FILL, BLOCKED_TILE_COLOR) : TILEMAP_TILE(TILE_SHAPE_EMPTY, 0);
+    }
+}
+
+// Every write to cells that changes how the board looks goes through here
+static void mark_cell_changed(SlotVector2 slot_pos)
+{
+    if (IsTilemapReady(boardTilemap)) {
+        SetTilemapTile(boardTilemap, slot_pos.x, slot_pos.y, get_cell_tile(slot_pos));
+    } else {
+        boardDirty = true;
+    }
+}
+
+// Upload every cell at once, after the board was rebuilt
+static void sync_board_tiles(void)
+{
+    static unsigned char tiles[SLOTS_Y][SLOTS_X];
+    for (int y = 0; y < SLOTS_Y; y++) {
+        for (int x = 0; x < SLOTS_X; x++) {
+            tiles[y][x] = get_cell_tile((SlotVector2) { x, y });
+        }
+    }
+    SetTilemapTiles(boardTilemap, &tiles[0][0]);
 }
 
 static inline Vector2 get_slot_origin(SlotVector2 slot_pos)
@@ -281,37 +738,129 @@ static inline Vector2 calc_position_centered_at_origin(Vector2 origin, Vector2 s
     return (Vector2) { .x = origin.x - size.x / 2, .y = origin.y - size.y / 2 };
 }
 
-static inline bool maybe_create_tower_at_position(SlotVector2 slot_pos)
+static inline Vector2 get_entity_center(Vector2 pos, Vector2 size)
 {
-    if (is_slot_occupied(slot_pos)) {
+    return (Vector2) { .x = pos.x + size.x / 2, .y = pos.y + size.y / 2 };
+}
+
+// O(1) lookup of the tower built on a slot, NULL if there is none
+static inline Tower *get_tower_at_slot(SlotVector2 slot_pos)
+{
+    if (!is_slot_in_bounds(slot_pos.x, slot_pos.y) || cells[slot_pos.x][slot_pos.y].kind != CELL_TOWER) {
+        return NULL;
+    }
+    return &lanes[lane_of_slot(slot_pos)].towers[cells[slot_pos.x][slot_pos.y].tower];
+}
+
+// Each level adds half of the base power and a quarter slot of range
+static inline int get_tower_power(const Tower *tower)
+{
+    return tower_defs[tower->kind].power + tower_defs[tower->kind].power * tower->level / 2;
+}
+
+static inline float get_tower_range(const Tower *tower)
+{
+    return tower_defs[tower->kind].range + tower->level * SQUARE_SIZE / 4;
+}
+
+static inline int get_tower_upgrade_cost(const Tower *tower)
+{
+    return tower_defs[tower->kind].cost * (tower->level + 1);
+}
+
+static inline int get_tower_sell_refund(const Tower *tower)
+{
+    return tower->invested * TOWER_SELL_REFUND_PERCENT / 100;
+}
+
+static inline bool maybe_create_tower_at_position(SlotVector2 slot_pos, TowerKind kind)
+{
+    if (!is_slot_in_bounds(slot_pos.x, slot_pos.y)) {
         return false;
     }
 
-    for (int i = 0; i < MAX_TOWERS; i++) {
-        if (!towers[i].alive) {
-            towers[i].alive = true;
-            towers[i].max_health = DEFAULT_TOWER_HEALTH;
-            towers[i].curr_health = DEFAULT_TOWER_HEALTH;
-            towers[i].color = DEFAULT_TOWER_COLOR;
-            towers[i].slot_pos = slot_pos;
-            towers[i].size = (Vector2) { SQUARE_SIZE / 2, SQUARE_SIZE / 2 };
+    int lane_index = lane_of_slot(slot_pos);
+    if (lane_index < 0 || is_slot_occupied(slot_pos)) {
+        return false;
+    }
 
-            slots_occupied[towers[i].slot_pos.x][towers[i].slot_pos.y] = true;
+    Lane *lane = &lanes[lane_index];
+    if (lane->tower_count == MAX_TOWERS) {
+        return false;
+    }
 
-            if (i >= MAX_TOWERS - 10) {
-                run_defrag();
-            }
-            break;
-        }
+    cells[slot_pos.x][slot_pos.y] = (Cell) { .kind = CELL_TOWER, .tower = lane->tower_count };
+
+    Tower *tower = &lane->towers[lane->tower_count++];
+    tower->alive = true;
+    tower->kind = kind;
+    tower->level = 0;
+    tower->invested = tower_defs[kind].cost;
+    tower->cooldown = 0;
+    tower->max_health = DEFAULT_TOWER_HEALTH;
+    tower->curr_health = DEFAULT_TOWER_HEALTH;
+    tower->color = tower_defs[kind].color;
+    tower->slot_pos = slot_pos;
+    tower->size = (Vector2) { SQUARE_SIZE / 2, SQUARE_SIZE / 2 };
+    mark_cell_changed(slot_pos);
+    return true;
+}
+
+// Swap the last tower of the lane into the freed index, so both the tower array and the cell index stay dense
+static inline void destroy_tower_at_position(SlotVector2 slot_pos)
+{
+    Lane *lane = &lanes[lane_of_slot(slot_pos)];
+    unsigned short index = cells[slot_pos.x][slot_pos.y].tower;
+    Tower *last = &lane->towers[--lane->tower_count];
+    if (index != lane->tower_count) {
+        lane->towers[index] = *last;
+        cells[last->slot_pos.x][last->slot_pos.y].tower = index;
+    }
+    last->alive = false;
+    cells[slot_pos.x][slot_pos.y] = (Cell) { .kind = CELL_EMPTY };
+    mark_cell_changed(slot_pos);
+}
+
+static bool maybe_sell_tower(Cursor cursor)
+{
+    SlotVector2 slot_pos = world_pos_to_slot_space(cursor.position);
+    Tower *tower = get_tower_at_slot(slot_pos);
+    if (tower == NULL || lane_of_slot(slot_pos) != LOCAL_PLAYER) {
+        return false;
+    }
+    player_gold[LOCAL_PLAYER] += get_tower_sell_refund(tower);
+    destroy_tower_at_position(slot_pos);
+    return true;
+}
+
+static bool maybe_upgrade_tower(Cursor cursor)
+{
+    SlotVector2 slot_pos = world_pos_to_slot_space(cursor.position);
+    Tower *tower = get_tower_at_slot(slot_pos);
+    if (tower == NULL || lane_of_slot(slot_pos) != LOCAL_PLAYER || tower->level == MAX_TOWER_LEVEL) {
+        return false;
+    }
+    int cost = get_tower_upgrade_cost(tower);
+    if (player_gold[LOCAL_PLAYER] < cost) {
+        return false;
     }
-    currentTowers++;
+    player_gold[LOCAL_PLAYER] -= cost;
+    tower->invested += cost;
+    tower->level++;
     return true;
 }
 
 bool maybe_purchase_tower(Cursor cursor)
 {
-    if (gold >= TOWER_COST && maybe_create_tower_at_position(world_pos_to_slot_space(cursor.position))) {
-        gold -= TOWER_COST;
+    // Players can only build inside their own lane
+    SlotVector2 slot_pos = world_pos_to_slot_space(cursor.position);
+    if (!is_slot_in_bounds(slot_pos.x, slot_pos.y) || lane_of_slot(slot_pos) != LOCAL_PLAYER) {
+        return false;
+    }
+
+    int cost = tower_defs[selectedTower].cost;
+    if (player_gold[LOCAL_PLAYER] >= cost && maybe_create_tower_at_position(slot_pos, selectedTower)) {
+        player_gold[LOCAL_PLAYER] -= cost;
         return true;
     }
     return false;
@@ -328,12 +877,837 @@ static inline bool create_path_at_position(SlotVector2 slot_pos)
     paths[slot_pos.x][slot_pos.y].slot_pos = slot_pos;
     paths[slot_pos.x][slot_pos.y].color = DEFAULT_PATH_COLOR;
 
-    slots_occupied[slot_pos.x][slot_pos.y] = true;
+    cells[slot_pos.x][slot_pos.y] = (Cell) { .kind = CELL_PATH };
+    mark_cell_changed(slot_pos);
 
     currentPaths++;
     return true;
 }
 
+// Lay out the lane strips side by side, one team per half of the board, and carve each lane's path
+static void create_lanes(void)
+{
+    for (int i = 0; i < LANE_COUNT; i++) {
+        int team = i / LANES_PER_TEAM;
+        int team_slot = i % LANES_PER_TEAM;
+
+        lanes[i].index = i;
+        lanes[i].team = team;
+        lanes[i].owner = i;
+        lanes[i].opponent_lane = (i + LANES_PER_TEAM) % LANE_COUNT;
+        lanes[i].next_lane = team_slot + 1 < LANES_PER_TEAM ? i + 1 : -1;
+        lanes[i].origin = (SlotVector2) { i * LANE_WIDTH + team * TEAM_GAP, 0 };
+        lanes[i].spawn_slot = (SlotVector2) { lanes[i].origin.x + lane_path_template[0].x, lane_path_template[0].y };
+
+        for (int k = 0; k < (int)(sizeof(lane_path_template) / sizeof(SlotVector2)); k++) {
+            create_path_at_position((SlotVector2) { lanes[i].origin.x + lane_path_template[k].x, lane_path_template[k].y });
+        }
+    }
+}
+
+// Breadth-first search from every path slot on the bottom row, so each path slot knows how far it is from its lane's exit
+static void compute_flow_field(void)
+{
+    static SlotVector2 queue[SLOTS_X * SLOTS_Y];
+    int head = 0;
+    int tail = 0;
+
+    for (int i = 0; i < SLOTS_X; i++) {
+        for (int j = 0; j < SLOTS_Y; j++) {
+            path_dist[i][j] = PATH_DIST_UNREACHABLE;
+        }
+        if (paths[i][SLOTS_Y - 1].alive) {
+            path_dist[i][SLOTS_Y - 1] = 0;
+            queue[tail++] = (SlotVector2) { i, SLOTS_Y - 1 };
+        }
+    }
+
+    static const int dirs[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    while (head < tail) {
+        SlotVector2 curr = queue[head++];
+        for (int d = 0; d < 4; d++) {
+            int x = (int)curr.x + dirs[d][0];
+            int y = (int)curr.y + dirs[d][1];
+            // Paths of neighbouring lanes can touch, but minions never cross between them
+            if (!is_slot_in_bounds(x, y) || !paths[x][y].alive || path_dist[x][y] != PATH_DIST_UNREACHABLE
+                || lane_of_slot((SlotVector2) { x, y }) != lane_of_slot(curr)) {
+                continue;
+            }
+            path_dist[x][y] = path_dist[curr.x][curr.y] + 1;
+            queue[tail++] = (SlotVector2) { x, y };
+        }
+    }
+}
+
+// Pick the neighbouring path slot that is closest to the goal
+static inline SlotVector2 next_slot_towards_goal(SlotVector2 slot_pos)
+{
+    static const int dirs[4][2] = { { 0, 1 }, { 1, 0 }, { -1, 0 }, { 0, -1 } };
+    SlotVector2 best = slot_pos;
+    for (int d = 0; d < 4; d++) {
+        int x = (int)slot_pos.x + dirs[d][0];
+        int y = (int)slot_pos.y + dirs[d][1];
+        if (is_slot_in_bounds(x, y) && path_dist[x][y] < path_dist[best.x][best.y]
+            && lane_of_slot((SlotVector2) { x, y }) == lane_of_slot(slot_pos)) {
+            best = (SlotVector2) { x, y };
+        }
+    }
+    return best;
+}
+
+static inline bool maybe_create_minion(Lane *lane, Minion minion)
+{
+    if (lane->minion_count == MAX_MINIONS) {
+        return false;
+    }
+    minion.position = calc_position_centered_at_origin(get_slot_origin(lane->spawn_slot), minion.size);
+    minion.target_slot = lane->spawn_slot;
+    minion.velocity = Vector2Zero();
+    lane->minions[lane->minion_count++] = minion;
+    return true;
+}
+
+static inline bool maybe_spawn_minion(Lane *lane, MinionKind kind)
+{
+    const MinionArchetype *archetype = &minion_archetypes[kind];
+    return maybe_create_minion(lane, (Minion) {
+        .alive = true,
+        .kind = kind,
+        .max_health = archetype->health,
+        .curr_health = archetype->health,
+        .speed = archetype->speed,
+        .size = (Vector2) { archetype->size, archetype->size },
+        .color = archetype->color,
+    });
+}
+
+// Spawn a whole group as one contiguous block, lined up behind the spawn slot so they walk in single file.
+// Returns how many minions actually fit in the lane
+static int spawn_minion_group(Lane *lane, MinionKind kind, int count)
+{
+    int first = lane->minion_count;
+    int spawned = 0;
+    while (spawned < count && maybe_spawn_minion(lane, kind)) {
+        spawned++;
+    }
+    for (int i = 1; i < spawned; i++) {
+        lane->minions[first + i].position.y -= i * SEND_GROUP_SPACING;
+    }
+    return spawned;
+}
+
+static void update_minions(Lane *lane)
+{
+    for (int i = 0; i < lane->minion_count; i++) {
+        Minion *minion = &lane->minions[i];
+        if (!minion->alive) {
+            continue;
+        }
+        Vector2 center = get_entity_center(minion->position, minion->size);
+        Vector2 target = get_slot_origin(minion->target_slot);
+        if (Vector2Distance(center, target) <= minion->speed) {
+            // Reached the center of the target slot, pick the next one along the flow field
+            if (path_dist[minion->target_slot.x][minion->target_slot.y] == 0) {
+                // Leaked, hand it off to the next lane once every lane is done with this tick
+                if (LIKELY(lane->leak_count < MAX_LANE_LEAKS)) {
+                    lane->leaks[lane->leak_count++] = *minion;
+                }
+                minion->alive = false;
+                continue;
+            }
+            minion->target_slot = next_slot_towards_goal(minion->target_slot);
+            target = get_slot_origin(minion->target_slot);
+        }
+        minion->velocity = Vector2Scale(Vector2Normalize(Vector2Subtract(target, center)), minion->speed);
+        minion->position = Vector2Add(minion->position, minion->velocity);
+    }
+}
+
+static inline int lane_cell_of_position(const Lane *lane, Vector2 pos)
+{
+    int x = (int)Clamp(pos.x / SQUARE_SIZE - lane->origin.x, 0, LANE_WIDTH - 1);
+    int y = (int)Clamp(pos.y / SQUARE_SIZE, 0, SLOTS_Y - 1);
+    return x * SLOTS_Y + y;
+}
+
+// Counting sort of all live minions of a lane into the slot they are centered on
+static void rebuild_minion_index(Lane *lane)
+{
+    for (int c = 0; c <= LANE_CELLS; c++) {
+        lane->cell_start[c] = 0;
+    }
+
+    for (int i = 0; i < lane->minion_count; i++) {
+        if (!lane->minions[i].alive) {
+            continue;
+        }
+        lane->minion_cells[i] = lane_cell_of_position(lane, get_entity_center(lane->minions[i].position, lane->minions[i].size));
+        lane->cell_start[lane->minion_cells[i] + 1]++;
+    }
+
+    unsigned short cell_fill[LANE_CELLS];
+    for (int c = 0; c < LANE_CELLS; c++) {
+        lane->cell_start[c + 1] += lane->cell_start[c];
+        cell_fill[c] = lane->cell_start[c];
+    }
+
+    for (int i = 0; i < lane->minion_count; i++) {
+        if (lane->minions[i].alive) {
+            lane->cell_items[cell_fill[lane->minion_cells[i]]++] = i;
+        }
+    }
+}
+
+// Query the lane's minion index for every live minion whose center is within radius of center
+static int query_minions_in_radius(const Lane *lane, Vector2 center, float radius, unsigned short *out, int max_out)
+{
+    int min_x = (int)Clamp((center.x - radius) / SQUARE_SIZE - lane->origin.x, 0, LANE_WIDTH - 1);
+    int max_x = (int)Clamp((center.x + radius) / SQUARE_SIZE - lane->origin.x, 0, LANE_WIDTH - 1);
+    int min_y = (int)Clamp((center.y - radius) / SQUARE_SIZE, 0, SLOTS_Y - 1);
+    int max_y = (int)Clamp((center.y + radius) / SQUARE_SIZE, 0, SLOTS_Y - 1);
+
+    int found = 0;
+    for (int x = min_x; x <= max_x; x++) {
+        for (int y = min_y; y <= max_y; y++) {
+            int c = x * SLOTS_Y + y;
+            for (int k = lane->cell_start[c]; k < lane->cell_start[c + 1]; k++) {
+                const Minion *minion = &lane->minions[lane->cell_items[k]];
+                if (minion->alive && Vector2Distance(center, get_entity_center(minion->position, minion->size)) <= radius) {
+                    if (found == max_out) {
+                        return found;
+                    }
+                    out[found++] = lane->cell_items[k];
+                }
+            }
+        }
+    }
+    return found;
+}
+
+// Returns the minion within radius closest to center that isn't in exclude, or -1
+static int find_closest_minion(const Lane *lane, Vector2 center, float radius, const unsigned short *exclude, int exclude_count)
+{
+    unsigned short candidates[MAX_MINIONS];
+    int count = query_minions_in_radius(lane, center, radius, candidates, MAX_MINIONS);
+    int best = -1;
+    float best_dist = radius;
+    for (int k = 0; k < count; k++) {
+        const Minion *minion = &lane->minions[candidates[k]];
+        bool excluded = false;
+        for (int e = 0; e < exclude_count; e++) {
+            excluded |= exclude[e] == candidates[k];
+        }
+        float dist = Vector2Distance(center, get_entity_center(minion->position, minion->size));
+        if (!excluded && dist <= best_dist) {
+            best = candidates[k];
+            best_dist = dist;
+        }
+    }
+    return best;
+}
+
+static inline void push_hit(Lane *lane, int minion, int damage)
+{
+    if (LIKELY(lane->hit_count < MAX_HITS)) {
+        lane->hits[lane->hit_count++] = (Hit) { .minion = minion, .damage = damage };
+    }
+}
+
+static inline void push_effect(Lane *lane, EffectKind kind, int variant, int damage, Vector2 position)
+{
+    if (LIKELY(lane->effect_count < MAX_LANE_EFFECTS)) {
+        lane->effects[lane->effect_count++] = (Effect) { kind, variant, damage, position };
+    }
+}
+
+static inline bool maybe_create_bullet(Lane *lane, Vector2 origin, Vector2 target, TowerKind source, int power)
+{
+    if (lane->bullet_count == MAX_PROJECTILES) {
+        return false;
+    }
+
+    const TowerDef *def = &tower_defs[source];
+    Bullet *bullet = &lane->bullets[lane->bullet_count++];
+    Vector2 delta = Vector2Subtract(target, origin);
+    bullet->alive = true;
+    bullet->source = source;
+    bullet->ttl = (int)ceilf(Vector2Length(delta) / def->projectile_speed);
+    bullet->size = (Vector2) { PROJECTILE_SIZE, PROJECTILE_SIZE };
+    bullet->position = calc_position_centered_at_origin(origin, bullet->size);
+    bullet->velocity = Vector2Scale(delta, 1.0f / (bullet->ttl > 0 ? bullet->ttl : 1));
+    bullet->base_power = power;
+    bullet->color = DEFAULT_PROJECTILE_COLOR;
+    return true;
+}
+
+// Towers target the minion in range that is closest to the goal
+static void update_towers(Lane *lane)
+{
+    unsigned short candidates[MAX_MINIONS];
+    for (int i = 0; i < lane->tower_count; i++) {
+        Tower *tower = &lane->towers[i];
+        if (!tower->alive || --tower->cooldown > 0) {
+            continue;
+        }
+        const TowerDef *def = &tower_defs[tower->kind];
+        Vector2 origin = get_slot_origin(tower->slot_pos);
+        int count = query_minions_in_radius(lane, origin, get_tower_range(tower), candidates, MAX_MINIONS);
+        if (count == 0) {
+            tower->cooldown = 0;
+            continue;
+        }
+
+        int target = candidates[0];
+        unsigned short target_dist = PATH_DIST_UNREACHABLE;
+        for (int k = 0; k < count; k++) {
+            SlotVector2 slot = lane->minions[candidates[k]].target_slot;
+            if (path_dist[slot.x][slot.y] < target_dist) {
+                target = candidates[k];
+                target_dist = path_dist[slot.x][slot.y];
+            }
+        }
+
+        if (def->projectile == PROJECTILE_INSTANT) {
+            push_hit(lane, target, get_tower_power(tower));
+        } else {
+            maybe_create_bullet(lane, origin, get_entity_center(lane->minions[target].position, lane->minions[target].size), tower->kind, get_tower_power(tower));
+        }
+        push_effect(lane, EFFECT_MUZZLE, tower->kind, 0, origin);
+        tower->cooldown = def->cooldown;
+    }
+}
+
+static void resolve_impact(Lane *lane, Vector2 point, int power, const TowerDef *def)
+{
+    unsigned short struck[MAX_MINIONS];
+    int count = 0;
+
+    switch (def->projectile) {
+    case PROJECTILE_SPLASH:
+        count = query_minions_in_radius(lane, point, def->splash_radius, struck, MAX_MINIONS);
+        for (int k = 0; k < count; k++) {
+            push_hit(lane, struck[k], power);
+        }
+        break;
+    case PROJECTILE_CHAIN: {
+        // Each bounce deals a quarter less damage than the previous one
+        int target = find_closest_minion(lane, point, PROJECTILE_IMPACT_RADIUS, NULL, 0);
+        while (target >= 0 && count <= def->chain_bounces) {
+            push_hit(lane, target, power);
+            struck[count++] = target;
+            power = power * 3 / 4;
+            target = find_closest_minion(lane, get_entity_center(lane->minions[target].position, lane->minions[target].size), def->chain_radius, struck, count);
+        }
+    } break;
+    case PROJECTILE_BULLET: {
+        int target = find_closest_minion(lane, point, PROJECTILE_IMPACT_RADIUS, NULL, 0);
+        if (target >= 0) {
+            push_hit(lane, target, power);
+        }
+    } break;
+    default:
+        UNREACHABLE();
+    }
+}
+
+static void update_bullets(Lane *lane)
+{
+    for (int i = 0; i < lane->bullet_count; i++) {
+        Bullet *bullet = &lane->bullets[i];
+        if (!bullet->alive) {
+            continue;
+        }
+        bullet->position = Vector2Add(bullet->position, bullet->velocity);
+        if (--bullet->ttl > 0) {
+            continue;
+        }
+        resolve_impact(lane, get_entity_center(bullet->position, bullet->size), bullet->base_power, &tower_defs[bullet->source]);
+        bullet->alive = false;
+    }
+}
+
+static int compare_hits(const void *a, const void *b)
+{
+    return (int)((const Hit *)a)->minion - (int)((const Hit *)b)->minion;
+}
+
+// Apply every hit collected this tick in one pass, sorted so each minion is only touched once
+static void resolve_hits(Lane *lane)
+{
+    qsort(lane->hits, lane->hit_count, sizeof(Hit), compare_hits);
+
+    int i = 0;
+    while (i < lane->hit_count) {
+        int m = lane->hits[i].minion;
+        int damage = 0;
+        for (; i < lane->hit_count && lane->hits[i].minion == m; i++) {
+            damage += lane->hits[i].damage;
+        }
+        Minion *minion = &lane->minions[m];
+        if (!minion->alive) {
+            continue;
+        }
+        minion->curr_health -= damage;
+        Vector2 center = get_entity_center(minion->position, minion->size);
+        if (minion->curr_health <= 0) {
+            minion->alive = false;
+            lane->bounty += minion_archetypes[minion->kind].bounty;
+            push_effect(lane, EFFECT_DEATH, minion->kind, damage, center);
+        } else {
+            push_effect(lane, EFFECT_HIT, minion->kind, damage, center);
+        }
+    }
+    lane->hit_count = 0;
+}
+
+// Advance a single lane by one tick. Only touches the lane's own partition plus read-only map data,
+// so lanes can be updated concurrently
+static void update_lane(Lane *lane)
+{
+    update_minions(lane);
+    rebuild_minion_index(lane);
+
+    // Towers and bullets only queue hits, damage is applied once all of them have been collected
+    update_towers(lane);
+    update_bullets(lane);
+    resolve_hits(lane);
+
+    // Defrag moves entities around, so only do it once nothing refers to them by index anymore
+    run_defrag(lane);
+}
+
+#if defined(SIM_THREADS)
+// Workers and the main thread pull lanes off a shared counter until every lane of the tick is done
+static void run_lane_jobs(void)
+{
+    int done = 0;
+    for (;;) {
+        int i = __atomic_fetch_add(&simNextLane, 1, __ATOMIC_ACQ_REL);
+        if (i >= LANE_COUNT) {
+            break;
+        }
+        PROFILE_BEGIN(PROFILE_LANE);
+        update_lane(&lanes[i]);
+        PROFILE_END(PROFILE_LANE);
+        done++;
+    }
+
+    if (done > 0) {
+        pthread_mutex_lock(&simMutex);
+        simLanesDone += done;
+        if (simLanesDone == LANE_COUNT) {
+            pthread_cond_signal(&simDoneCond);
+        }
+        pthread_mutex_unlock(&simMutex);
+    }
+}
+
+static void *sim_worker(void *arg)
+{
+    (void)arg;
+#ifdef PROFILER
+    char name[32];
+    snprintf(name, sizeof(name), "sim worker %d", (int)(intptr_t)arg);
+    SetProfileThreadName(name);
+#endif
+    unsigned int seen = 0;
+    pthread_mutex_lock(&simMutex);
+    for (;;) {
+        while (simGeneration == seen && !simShutdown) {
+            pthread_cond_wait(&simStartCond, &simMutex);
+        }
+        if (simShutdown) {
+            break;
+        }
+        seen = simGeneration;
+        pthread_mutex_unlock(&simMutex);
+        run_lane_jobs();
+        pthread_mutex_lock(&simMutex);
+    }
+    pthread_mutex_unlock(&simMutex);
+    return NULL;
+}
+
+static void start_sim_workers(void)
+{
+    if (simWorkersStarted) {
+        return;
+    }
+    simShutdown = false;
+    for (int i = 0; i < SIM_WORKER_COUNT; i++) {
+        pthread_create(&simWorkers[i], NULL, sim_worker, (void *)(intptr_t)i);
+    }
+    simWorkersStarted = true;
+}
+
+static void stop_sim_workers(void)
+{
+    if (!simWorkersStarted) {
+        return;
+    }
+    pthread_mutex_lock(&simMutex);
+    simShutdown = true;
+    pthread_cond_broadcast(&simStartCond);
+    pthread_mutex_unlock(&simMutex);
+    for (int i = 0; i < SIM_WORKER_COUNT; i++) {
+        pthread_join(simWorkers[i], NULL);
+    }
+    simWorkersStarted = false;
+}
+#endif
+
+static void update_all_lanes(void)
+{
+#if defined(SIM_THREADS)
+    pthread_mutex_lock(&simMutex);
+    // A worker that woke up late for the previous tick may still be racing on the counter
+    __atomic_store_n(&simNextLane, 0, __ATOMIC_RELEASE);
+    simLanesDone = 0;
+    simGeneration++;
+    pthread_cond_broadcast(&simStartCond);
+    pthread_mutex_unlock(&simMutex);
+
+    run_lane_jobs();
+
+    pthread_mutex_lock(&simMutex);
+    while (simLanesDone < LANE_COUNT) {
+        pthread_cond_wait(&simDoneCond, &simMutex);
+    }
+    pthread_mutex_unlock(&simMutex);
+#else
+    for (int i = 0; i < LANE_COUNT; i++) {
+        PROFILE_BEGIN(PROFILE_LANE);
+        update_lane(&lanes[i]);
+        PROFILE_END(PROFILE_LANE);
+    }
+#endif
+}
+
+// The only point where lanes exchange data: leaked minions move on to the next lane of their team,
+// or cost the team a life once they leak out of its last lane
+static void sync_lanes(void)
+{
+    for (int i = 0; i < LANE_COUNT; i++) {
+        Lane *lane = &lanes[i];
+        for (int k = 0; k < lane->leak_count; k++) {
+            // A full catching lane cannot drop the minion for free, it costs a life as if it had leaked out of the last lane
+            if (lane->next_lane >= 0 && maybe_create_minion(&lanes[lane->next_lane], lane->leaks[k])) {
+                continue;
+            }
+            if (lives[lane->team] > 0) {
+                lives[lane->team]--;
+            }
+        }
+        lane->leak_count = 0;
+
+        player_gold[lane->owner] += lane->bounty;
+        lane->bounty = 0;
+    }
+
+    for (int i = 0; i < TEAM_COUNT; i++) {
+        if (lives[i] == 0) {
+            gameOver = true;
+        }
+    }
+}
+
+// Advance particles and damage numbers and turn the effects of the tick into new ones
+static void update_effects(void)
+{
+    UpdateParticles();
+    UpdateDamageNumbers();
+
+    for (int i = 0; i < LANE_COUNT; i++) {
+        Lane *lane = &lanes[i];
+        for (int k = 0; k < lane->effect_count; k++) {
+            const Effect *effect = &lane->effects[k];
+            ParticleBurst burst = effect_bursts[effect->kind];
+            burst.position = effect->position;
+            switch (effect->kind) {
+            case EFFECT_MUZZLE:
+                burst.color = MUZZLE_PALETTE_INDEX + effect->variant;
+                break;
+            case EFFECT_HIT:
+                burst.color = HIT_PALETTE_INDEX;
+                break;
+            case EFFECT_DEATH:
+                burst.color = effect->variant;
+                break;
+            }
+            EmitParticles(burst);
+            if (effect->damage > 0) {
+                SpawnDamageNumber(effect->damage, effect->position);
+            }
+        }
+        lane->effect_count = 0;
+    }
+}
+
+static int compare_spawn_events(const void *a, const void *b)
+{
+    const SpawnEvent *ea = a;
+    const SpawnEvent *eb = b;
+    if (ea->tick != eb->tick) {
+        return ea->tick - eb->tick;
+    }
+    return ea->lane != eb->lane ? ea->lane - eb->lane : ea->kind - eb->kind;
+}
+
+// Expand every wave definition into individual bursts and sort them by tick
+static void compile_spawn_timeline(void)
+{
+    spawnTimelineLength = 0;
+    spawnTimelineCursor = 0;
+    int dropped = 0;
+    for (int w = 0; w < (int)(sizeof(wave_defs) / sizeof(WaveDef)); w++) {
+        const WaveDef *wave = &wave_defs[w];
+        for (int g = 0; g < wave->groups; g++) {
+            for (int l = 0; l < LANE_COUNT; l++) {
+                if (!(wave->lanes & (1u << l))) {
+                    continue;
+                }
+                if (spawnTimelineLength == MAX_SPAWN_EVENTS) {
+                    dropped++;
+                    continue;
+                }
+                spawn_timeline[spawnTimelineLength++] = (SpawnEvent) {
+                    .tick = wave->start + g * wave->spacing,
+                    .lane = l,
+                    .kind = wave->kind,
+                    .count = wave->count,
+                };
+            }
+        }
+    }
+    if (dropped > 0) {
+        TraceLog(LOG_WARNING, "WAVES: Spawn timeline is full, %d bursts dropped (raise MAX_SPAWN_EVENTS)", dropped);
+    }
+    qsort(spawn_timeline, spawnTimelineLength, sizeof(SpawnEvent), compare_spawn_events);
+}
+
+// Emit every burst due this tick. Ticks without spawns only pay for a single comparison
+static void advance_spawn_timeline(void)
+{
+    while (spawnTimelineCursor < spawnTimelineLength && spawn_timeline[spawnTimelineCursor].tick <= framesCounter) {
+        const SpawnEvent *event = &spawn_timeline[spawnTimelineCursor++];
+        spawn_minion_group(&lanes[event->lane], event->kind, event->count);
+    }
+}
+
+// Queue a send for the player. All the bookkeeping left for the hot path is bumping a counter
+static bool maybe_queue_send(int player, MinionKind kind)
+{
+    const MinionArchetype *archetype = &minion_archetypes[kind];
+    if (player_gold[player] < archetype->send_cost) {
+        return false;
+    }
+    player_gold[player] -= archetype->send_cost;
+    player_income[player] += archetype->send_income;
+    send_queues[player].pending[kind]++;
+    return true;
+}
+
+// Pay out income to every player in one batch
+static void apply_income(void)
+{
+    for (int i = 0; i < PLAYER_COUNT; i++) {
+        player_gold[i] += player_income[i];
+    }
+}
+
+// Turn every player's queued sends into one spawn group per archetype in the opposing lane
+static void flush_sends(void)
+{
+    for (int i = 0; i < PLAYER_COUNT; i++) {
+        Lane *target = &lanes[lanes[i].opponent_lane];
+        for (int k = 0; k < MINION_KIND_COUNT; k++) {
+            if (send_queues[i].pending[k] > 0) {
+                // Sends are paid for when queued, whatever does not fit in a full lane waits for the next flush
+                send_queues[i].pending[k] -= spawn_minion_group(target, k, send_queues[i].pending[k]);
+            }
+        }
+    }
+}
+
+static const SimTask sim_tasks[] = {
+    { INCOME_INTERVAL, apply_income },
+    { SEND_FLUSH_INTERVAL, flush_sends },
+};
+
+// Run every scheduled task that is due this tick. Tasks are skipped on tick 0 so nothing fires before the game starts
+static void run_sim_tasks(void)
+{
+    for (int i = 0; i < (int)(sizeof(sim_tasks) / sizeof(SimTask)); i++) {
+        if (framesCounter > 0 && framesCounter % sim_tasks[i].period == 0) {
+            sim_tasks[i].run();
+        }
+    }
+}
+
+// World rectangle currently on screen
+static Rectangle get_camera_view(void)
+{
+    Vector2 top_left = GetScreenToWorld2D(Vector2Zero(), camera);
+    Vector2 bottom_right = GetScreenToWorld2D((Vector2) { screenWidth, screenHeight }, camera);
+    return (Rectangle) { top_left.x, top_left.y, bottom_right.x - top_left.x, bottom_right.y - top_left.y };
+}
+
+// Slots overlapping the view, grown by margin slots and clamped to the board
+static SlotRect get_visible_slots(Rectangle view, int margin)
+{
+    return (SlotRect) {
+        .min_x = (int)Clamp(floorf(view.x / SQUARE_SIZE) - margin, 0, SLOTS_X - 1),
+        .min_y = (int)Clamp(floorf(view.y / SQUARE_SIZE) - margin, 0, SLOTS_Y - 1),
+        .max_x = (int)Clamp(floorf((view.x + view.width) / SQUARE_SIZE) + margin, 0, SLOTS_X - 1),
+        .max_y = (int)Clamp(floorf((view.y + view.height) / SQUARE_SIZE) + margin, 0, SLOTS_Y - 1),
+    };
+}
+
+// Pan just enough to bring the cursor back on screen
+static void keep_cursor_in_view(void)
+{
+    Rectangle view = get_camera_view();
+    if (cursor.position.x < view.x) {
+        camera.target.x -= view.x - cursor.position.x;
+    } else if (cursor.position.x + cursor.size.x > view.x + view.width) {
+        camera.target.x += cursor.position.x + cursor.size.x - (view.x + view.width);
+    }
+    if (cursor.position.y < view.y) {
+        camera.target.y -= view.y - cursor.position.y;
+    } else if (cursor.position.y + cursor.size.y > view.y + view.height) {
+        camera.target.y += cursor.position.y + cursor.size.y - (view.y + view.height);
+    }
+}
+
+// Mouse wheel zooms around the pointer and +/- around the screen center, dragging with the right button pans
+static void update_camera(void)
+{
+    float zoom_steps = GetMouseWheelMove();
+    Vector2 anchor = GetMousePosition();
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_MINUS)) {
+        zoom_steps = IsKeyPressed(KEY_EQUAL) ? 1.0f : -1.0f;
+        anchor = (Vector2) { screenWidth / 2, screenHeight / 2 };
+    }
+
+    if (zoom_steps != 0.0f) {
+        // Keep the world point under the anchor where it is
+        camera.target = GetScreenToWorld2D(anchor, camera);
+        camera.offset = anchor;
+        camera.zoom = Clamp(camera.zoom * (1.0f + CAMERA_ZOOM_STEP * zoom_steps), MIN_CAMERA_ZOOM, MAX_CAMERA_ZOOM);
+    }
+
+    if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+        camera.target = Vector2Subtract(camera.target, Vector2Scale(GetMouseDelta(), 1.0f / camera.zoom));
+    }
+
+    camera.target = Vector2Clamp(camera.target, Vector2Zero(), (Vector2) { SLOTS_X * SQUARE_SIZE, SLOTS_Y * SQUARE_SIZE });
+}
+
+// Decide which visible slots are drawn as heat tiles and fill in their texels: opacity shows the density and color the
+// remaining health. Returns false when every slot is drawn minion by minion
+static bool aggregate_crowds(SlotRect visible)
+{
+    memset(crowded, 0, sizeof(crowded));
+    if (camera.zoom >= LOD_MAX_ZOOM) {
+        return false;
+    }
+
+    int crowd_size = (int)ceilf(LOD_CROWD_SIZE * camera.zoom / LOD_MAX_ZOOM);
+    bool any = false;
+    memset(crowdTexels, 0, sizeof(crowdTexels));
+    for (int l = 0; l < LANE_COUNT; l++) {
+        const Lane *lane = &lanes[l];
+        int min_x = (int)Clamp(visible.min_x - (int)lane->origin.x, 0, LANE_WIDTH);
+        int max_x = (int)Clamp(visible.max_x - (int)lane->origin.x, -1, LANE_WIDTH - 1);
+        for (int x = min_x; x <= max_x; x++) {
+            for (int y = visible.min_y; y <= visible.max_y; y++) {
+                int c = x * SLOTS_Y + y;
+                if (lane->cell_start[c + 1] - lane->cell_start[c] < crowd_size) {
+                    continue;
+                }
+
+                // Minions that died since the index was built are skipped, they don't count towards the density
+                int count = 0;
+                int health = 0;
+                int max_health = 0;
+                for (int k = lane->cell_start[c]; k < lane->cell_start[c + 1]; k++) {
+                    if (lane->cell_items[k] == INDEX_NONE || !lane->minions[lane->cell_items[k]].alive) {
+                        continue;
+                    }
+                    count++;
+                    health += lane->minions[lane->cell_items[k]].curr_health;
+                    max_health += lane->minions[lane->cell_items[k]].max_health;
+                }
+                if (count < crowd_size) {
+                    continue;
+                }
+
+                float healthy = max_health > 0 ? (float)health / max_health : 0.0f;
+                Color color = {
+                    (unsigned char)Lerp(LOD_WOUNDED_COLOR.r, LOD_HEALTHY_COLOR.r, healthy),
+                    (unsigned char)Lerp(LOD_WOUNDED_COLOR.g, LOD_HEALTHY_COLOR.g, healthy),
+                    (unsigned char)Lerp(LOD_WOUNDED_COLOR.b, LOD_HEALTHY_COLOR.b, healthy),
+                    255,
+                };
+                int slot_x = lane->origin.x + x;
+                crowded[slot_x][y] = true;
+                crowdTexels[y][slot_x] = ColorAlpha(color, Clamp((float)count / LOD_FULL_DENSITY, 0.5f, 1.0f));
+                any = true;
+            }
+        }
+    }
+    return any;
+}
+
+// Draw the placeholder sprites and pack them, in the order of Sprite
+static void load_sprites(void)
+{
+    AtlasBuilder builder = { 0 };
+
+    for (int i = 0; i < TOWER_KIND_COUNT; i++) {
+        Image image = GenImageColor(SQUARE_SIZE, SQUARE_SIZE, tower_defs[i].color);
+        ImageDrawRectangleLines(&image, (Rectangle) { 0, 0, SQUARE_SIZE, SQUARE_SIZE }, BORDER_THICKNESS, ColorBrightness(tower_defs[i].color, -0.3f));
+        AddAtlasImage(&builder, image);
+    }
+
+    Image gold = GenImageColor(HUD_ICON_SIZE, HUD_ICON_SIZE, BLANK);
+    ImageDrawCircle(&gold, HUD_ICON_SIZE / 2, HUD_ICON_SIZE / 2, HUD_ICON_SIZE / 2 - 1, ORANGE);
+    ImageDrawCircle(&gold, HUD_ICON_SIZE / 2, HUD_ICON_SIZE / 2, HUD_ICON_SIZE / 2 - 3, GOLD);
+    AddAtlasImage(&builder, gold);
+
+    Image heart = GenImageColor(HUD_ICON_SIZE, HUD_ICON_SIZE, BLANK);
+    ImageDrawCircle(&heart, HUD_ICON_SIZE / 4 + 1, HUD_ICON_SIZE / 3, HUD_ICON_SIZE / 4, RED);
+    ImageDrawCircle(&heart, HUD_ICON_SIZE * 3 / 4 - 1, HUD_ICON_SIZE / 3, HUD_ICON_SIZE / 4, RED);
+    ImageDrawTriangle(&heart, (Vector2) { 1, HUD_ICON_SIZE / 3 + 2 }, (Vector2) { HUD_ICON_SIZE / 2, HUD_ICON_SIZE - 1 }, (Vector2) { HUD_ICON_SIZE - 1, HUD_ICON_SIZE / 3 + 2 }, RED);
+    AddAtlasImage(&builder, heart);
+
+    Image digit_images[10];
+    int cell_width = 0;
+    for (int i = 0; i < 10; i++) {
+        char digit[2] = { '0' + i, '\0' };
+        digit_images[i] = ImageText(digit, DIGIT_FONT_SIZE, WHITE);
+        if (digit_images[i].width > cell_width) {
+            cell_width = digit_images[i].width;
+        }
+    }
+    Image digits = GenImageColor(10 * cell_width, digit_images[0].height, BLANK);
+    for (int i = 0; i < 10; i++) {
+        Rectangle source = { 0, 0, digit_images[i].width, digit_images[i].height };
+        Rectangle dest = { i * cell_width + (cell_width - digit_images[i].width) / 2, 0, source.width, source.height };
+        ImageDraw(&digits, digit_images[i], source, dest, WHITE);
+        UnloadImage(digit_images[i]);
+    }
+    AddAtlasImage(&builder, digits);
+
+    spriteAtlas = BuildAtlas(&builder, ATLAS_WIDTH);
+    SetDamageNumberDigits(spriteAtlas.texture, spriteAtlas.sprites[SPRITE_DIGITS]);
+
+    // Shapes sample the atlas' white texel, so they batch together with sprites
+    defaultShapesTexture = GetShapesTexture();
+    defaultShapesRec = GetShapesTextureRectangle();
+    SetShapesTexture(spriteAtlas.texture, spriteAtlas.white);
+}
+
 // Initialize game variables
 void InitGame(void)
 {
@@ -351,38 +1725,113 @@ void InitGame(void)
     cursor.size = (Vector2) { SQUARE_SIZE, SQUARE_SIZE };
     cursor.color = CURSOR_COLOR;
 
-    INIT_PATHS(SlotVector2, create_path_at_position,
-        { 8, 0 }, { 8, 1 }, { 8, 2 },
-        { 8, 3 }, { 8, 4 }, { 8, 5 },
-        { 8, 6 }, { 8, 7 },
-        { 9, 0 }, { 9, 1 }, { 9, 2 },
-        { 9, 3 }, { 9, 4 }, { 9, 5 },
-        { 9, 6 }, { 9, 7 },
-        { 10, 6 }, { 10, 7 },
-        { 11, 6 }, { 11, 7 },
-        { 12, 6 }, { 12, 7 },
-        { 13, 6 }, { 13, 7 },
-        { 14, 6 }, { 14, 7 },
-        { 15, 6 }, { 15, 7 },
-        { 15, 0 }, { 15, 1 }, { 15, 2 },
-        { 15, 3 }, { 15, 4 }, { 15, 5 },
-        { 16, 6 }, { 16, 7 },
-        { 16, 0 }, { 16, 1 }, { 16, 2 },
-        { 16, 3 }, { 16, 4 }, { 16, 5 },
-        { 11, 8 }, { 11, 9 }, { 11, 10 },
-        { 11, 11 }, { 11, 12 }, { 11, 13 },
-        { 12, 8 }, { 12, 9 }, { 12, 10 },
-        { 12, 11 }, { 12, 12 }, { 12, 13 },
-        { 13, 8 }, { 13, 9 }, { 13, 10 },
-        { 13, 11 }, { 13, 12 }, { 13, 13 }, );
+    camera = (Camera2D) { .zoom = 1.0f };
+
+    if (!gpuResourcesLoaded) {
+        gpuResourcesLoaded = true;
+        boardTilemap = LoadTilemap(SLOTS_X, SLOTS_Y, SQUARE_SIZE);
+        if (IsTilemapReady(boardTilemap)) {
+            Color tile_palette[MAX_TILEMAP_COLORS] = { 0 };
+            for (int i = 0; i < TOWER_KIND_COUNT; i++) {
+                tile_palette[i] = tower_defs[i].color;
+            }
+            tile_palette[PATH_TILE_COLOR] = DEFAULT_PATH_COLOR;
+            tile_palette[BLOCKED_TILE_COLOR] = BLOCKED_CELL_COLOR;
+            SetTilemapColors(boardTilemap, tile_palette, MAX_TILEMAP_COLORS, GRID_COLOR, RAYWHITE);
+        } else {
+            boardLayer = LoadRenderTexture(screenWidth, screenHeight);
+        }
+
+        InitInstancing(MAX_RECT_INSTANCES);
+        InitOverlays();
+        Color palette[MAX_INSTANCE_COLORS] = { 0 };
+        for (int i = 0; i < MINION_KIND_COUNT; i++) {
+            palette[i] = minion_archetypes[i].color;
+        }
+        palette[PROJECTILE_PALETTE_INDEX] = DEFAULT_PROJECTILE_COLOR;
+        for (int i = 0; i < TOWER_KIND_COUNT; i++) {
+            palette[MUZZLE_PALETTE_INDEX + i] = tower_defs[i].color;
+        }
+        palette[HIT_PALETTE_INDEX] = HIT_PARTICLE_COLOR;
+        SetInstancePalette(palette, MAX_INSTANCE_COLORS);
+
+        load_sprites();
+
+        Image heat = GenImageColor(SLOTS_X, SLOTS_Y, BLANK);
+        crowdHeat = LoadTextureFromImage(heat);
+        UnloadImage(heat);
+    }
+    boardDirty = true;
+
+    memset(cells, 0, sizeof(cells));
+    memset(paths, 0, sizeof(paths));
+    memset(lanes, 0, sizeof(lanes));
+    currentPaths = 0;
+    ResetParticles();
+    ResetDamageNumbers();
+
+    create_lanes();
+    if (IsTilemapReady(boardTilemap)) {
+        sync_board_tiles();
+    }
+
+    compute_flow_field();
+
+    for (int i = 0; i < PLAYER_COUNT; i++) {
+        player_gold[i] = STARTING_GOLD;
+        player_income[i] = STARTING_INCOME;
+    }
+    memset(send_queues, 0, sizeof(send_queues));
+    for (int i = 0; i < TEAM_COUNT; i++) {
+        lives[i] = TEAM_LIVES;
+    }
+    compile_spawn_timeline();
+    selectedTower = TOWER_BASIC;
+
+#if defined(SIM_THREADS)
+    start_sim_workers();
+#endif
+}
+
+// Update simulation (one tick)
+void UpdateSim(void)
+{
+    PROFILE_BEGIN(PROFILE_SIM_TASKS);
+    advance_spawn_timeline();
+
+    // Scheduled tasks may inject minions into any lane, so they run before the lanes are split across threads
+    run_sim_tasks();
+    PROFILE_END(PROFILE_SIM_TASKS);
+
+    PROFILE_BEGIN(PROFILE_SIM_LANES);
+    update_all_lanes();
+    PROFILE_END(PROFILE_SIM_LANES);
+
+    PROFILE_BEGIN(PROFILE_SIM_SYNC);
+    sync_lanes();
+    update_effects();
+    PROFILE_END(PROFILE_SIM_SYNC);
 }
 
 // Update game (one frame)
 void UpdateGame(void)
 {
+    PROFILE_BEGIN(PROFILE_INPUT);
+    bool tick = false;
+
     if (!gameOver) {
         if (IsKeyPressed('P'))
             pause = !pause;
+        if (IsKeyPressed(KEY_R)) {
+            showAllRanges = !showAllRanges;
+        }
+#ifdef PROFILER
+        if (IsKeyPressed(KEY_F3)) {
+            showProfiler = !showProfiler;
+        }
+#endif
+
+        update_camera();
 
         allowMove = true;
 
@@ -404,96 +1853,351 @@ void UpdateGame(void)
                 cursor.position.y += SQUARE_SIZE;
                 allowMove = false;
             }
+            if (!allowMove) {
+                // Keep the cursor on the board, slot conversions truncate and must never see a negative position
+                cursor.position.x = Clamp(cursor.position.x, offset.x / 2, (SLOTS_X - 1) * SQUARE_SIZE + offset.x / 2);
+                cursor.position.y = Clamp(cursor.position.y, offset.y / 2, (SLOTS_Y - 1) * SQUARE_SIZE + offset.y / 2);
+                keep_cursor_in_view();
+            }
+            for (int i = 0; i < TOWER_KIND_COUNT; i++) {
+                if (IsKeyPressed(KEY_ONE + i)) {
+                    selectedTower = i;
+                }
+            }
+            for (int i = 0; i < MINION_KIND_COUNT; i++) {
+                if (IsKeyPressed(minion_send_keys[i])) {
+                    maybe_queue_send(LOCAL_PLAYER, i);
+                }
+            }
             if (IsKeyPressed(KEY_ENTER)) {
                 maybe_purchase_tower(cursor);
             }
+            if (IsKeyPressed(KEY_U)) {
+                maybe_upgrade_tower(cursor);
+            }
+            if (IsKeyPressed(KEY_X)) {
+                maybe_sell_tower(cursor);
+            }
 
-            framesCounter++;
+            tick = true;
         }
     } else if (IsKeyPressed(KEY_ENTER)) {
         InitGame();
         gameOver = false;
     }
+    PROFILE_END(PROFILE_INPUT);
+
+    if (tick) {
+        UpdateSim();
+        framesCounter++;
+    }
+}
+
+// Check whether the label shows other values than last frame, and remember them
+static bool hud_label_changed(HudLabel *label, int a, int b, int c)
+{
+    if (label->layout.quadCount > 0 && label->values[0] == a && label->values[1] == b && label->values[2] == c) {
+        return false;
+    }
+    label->values[0] = a;
+    label->values[1] = b;
+    label->values[2] = c;
+    return true;
+}
+
+// Range of a tower as a faint disc with a ring around it, skipped when it doesn't reach into the view
+static void draw_tower_range(Vector2 center, float range, Color color, Rectangle view)
+{
+    if (!CheckCollisionCircleRec(center, range, view)) {
+        return;
+    }
+    DrawOverlayCircle(center, range, Fade(color, RANGE_FILL_ALPHA));
+    DrawOverlayRing(center, range, RANGE_RING_THICKNESS, color);
+}
+
+// Draw the static part of the board inside a slot range, when the tilemap shader isn't supported
+static void draw_board(SlotRect area)
+{
+    float left = area.min_x * SQUARE_SIZE + offset.x / 2;
+    float right = (area.max_x + 1) * SQUARE_SIZE + offset.x / 2;
+    float top = area.min_y * SQUARE_SIZE + offset.y / 2;
+    float bottom = (area.max_y + 1) * SQUARE_SIZE + offset.y / 2;
+
+    // Draw grid lines
+    for (int i = area.min_x; i <= area.max_x + 1; i++) {
+        DrawLineV((Vector2) { SQUARE_SIZE * i + offset.x / 2, top }, (Vector2) { SQUARE_SIZE * i + offset.x / 2, bottom }, GRID_COLOR);
+    }
+
+    for (int i = area.min_y; i <= area.max_y + 1; i++) {
+        DrawLineV((Vector2) { left, SQUARE_SIZE * i + offset.y / 2 }, (Vector2) { right, SQUARE_SIZE * i + offset.y / 2 }, GRID_COLOR);
+    }
+
+    // The gap between the teams can't be built on
+    for (int i = area.min_x; i <= area.max_x; i++) {
+        if (lane_of_slot((SlotVector2) { i, 0 }) < 0) {
+            Vector2 origin = calc_position_centered_at_origin(get_slot_origin((SlotVector2) { i, area.min_y }), (Vector2) { SQUARE_SIZE, SQUARE_SIZE });
+            DrawRectangleV(origin, (Vector2) { SQUARE_SIZE, SQUARE_SIZE * (area.max_y - area.min_y + 1) }, BLOCKED_CELL_COLOR);
+        }
+    }
+
+    // Iterate the paths in range
+    for (int i = area.min_x; i <= area.max_x; i++) {
+        for (int j = area.min_y; j <= area.max_y; j++) {
+            if (!paths[i][j].alive) {
+                continue;
+            }
+            Vector2 origin = get_slot_origin((SlotVector2) { i, j });
+            Vector2 offset_pos = calc_position_centered_at_origin(origin, (Vector2) { SQUARE_SIZE, SQUARE_SIZE });
+            DrawRectangleV(offset_pos, (Vector2) { SQUARE_SIZE, SQUARE_SIZE }, paths[i][j].color);
+        }
+    }
+
+    // Iterate the towers in range
+    for (int l = 0; l < LANE_COUNT; l++) {
+        const Lane *lane = &lanes[l];
+        for (int i = 0; i < lane->tower_count; i++) {
+            SlotVector2 slot_pos = lane->towers[i].slot_pos;
+            if ((int)slot_pos.x < area.min_x || (int)slot_pos.x > area.max_x || (int)slot_pos.y < area.min_y || (int)slot_pos.y > area.max_y) {
+                continue;
+            }
+            Vector2 offset_pos = calc_position_centered_at_origin(get_slot_origin(slot_pos), lane->towers[i].size);
+            DrawAtlasSprite(spriteAtlas, SPRITE_TOWER + lane->towers[i].kind, pos_and_size_to_rect(offset_pos, lane->towers[i].size), WHITE);
+        }
+    }
+}
+
+// Render the static part of the board into boardLayer
+static void redraw_board_layer(void)
+{
+    BeginTextureMode(boardLayer);
+    ClearBackground(RAYWHITE);
+    draw_board((SlotRect) { 0, 0, SLOTS_X - 1, SLOTS_Y - 1 });
+    EndTextureMode();
+    boardDirty = false;
 }
 
 // Draw game (one frame)
 void DrawGame(void)
 {
+    PROFILE_BEGIN(PROFILE_DRAW_LIST);
+    bool use_tilemap = IsTilemapReady(boardTilemap);
+    bool use_layer = !use_tilemap && IsRenderTextureReady(boardLayer);
+    if (use_layer && boardDirty) {
+        redraw_board_layer();
+    }
+
     BeginDrawing();
 
     ClearBackground(RAYWHITE);
 
     if (!gameOver) {
-        // Draw grid lines
-        for (int i = 0; i < screenWidth / SQUARE_SIZE + 1; i++) {
-            DrawLineV((Vector2) { SQUARE_SIZE * i + offset.x / 2, offset.y / 2 }, (Vector2) { SQUARE_SIZE * i + offset.x / 2, screenHeight - offset.y / 2 }, LIGHTGRAY);
+        BeginMode2D(camera);
+
+        // Only what the camera sees is drawn, tiles by the slot grid and minions through the lanes' minion index
+        Rectangle view = get_camera_view();
+        SlotRect tiles = get_visible_slots(view, 0);
+        SlotRect cull_slots = get_visible_slots(view, CULL_MARGIN_SLOTS);
+        Rectangle tiles_rect = {
+            tiles.min_x,
+            tiles.min_y,
+            tiles.max_x - tiles.min_x + 1,
+            tiles.max_y - tiles.min_y + 1,
+        };
+
+        if (use_tilemap) {
+            DrawTilemapRegion(boardTilemap, tiles_rect, Vector2Zero());
+        } else if (use_layer) {
+            // Blit the visible part of the static board layer, render textures are stored upside down
+            Vector2 position = { tiles_rect.x * SQUARE_SIZE, tiles_rect.y * SQUARE_SIZE };
+            float height = tiles_rect.height * SQUARE_SIZE;
+            Rectangle source = { position.x, screenHeight - position.y - height, tiles_rect.width * SQUARE_SIZE, -height };
+            DrawTextureRec(boardLayer.texture, source, position, WHITE);
+        } else {
+            draw_board(tiles);
         }
 
-        for (int i = 0; i < screenHeight / SQUARE_SIZE + 1; i++) {
-            DrawLineV((Vector2) { offset.x / 2, SQUARE_SIZE * i + offset.y / 2 }, (Vector2) { screenWidth - offset.x / 2, SQUARE_SIZE * i + offset.y / 2 }, LIGHTGRAY);
+        // Crowded slots are a single texel of the heat texture, stretched over the slot
+        bool lod = aggregate_crowds(cull_slots);
+        if (lod) {
+            UpdateTexture(crowdHeat, crowdTexels);
+            Rectangle source = { cull_slots.min_x, cull_slots.min_y, cull_slots.max_x - cull_slots.min_x + 1, cull_slots.max_y - cull_slots.min_y + 1 };
+            Rectangle dest = { source.x * SQUARE_SIZE, source.y * SQUARE_SIZE, source.width * SQUARE_SIZE, source.height * SQUARE_SIZE };
+            DrawTexturePro(crowdHeat, source, dest, Vector2Zero(), 0.0f, WHITE);
         }
 
-        // Iterate all towers
-        int tower_count = currentTowers;
-        for (int i = 0; i < MAX_TOWERS; i++) {
-            if (!towers[i].alive) {
-                continue;
+        // Pack the minions, then the bullets of every visible lane and then the particles, so effects end up on top
+        Rectangle cull_rect = {
+            view.x - CULL_MARGIN_SLOTS * SQUARE_SIZE,
+            view.y - CULL_MARGIN_SLOTS * SQUARE_SIZE,
+            view.width + 2 * CULL_MARGIN_SLOTS * SQUARE_SIZE,
+            view.height + 2 * CULL_MARGIN_SLOTS * SQUARE_SIZE,
+        };
+        int instance_count = 0;
+        for (int l = 0; l < LANE_COUNT; l++) {
+            const Lane *lane = &lanes[l];
+            int min_x = (int)Clamp(cull_slots.min_x - (int)lane->origin.x, 0, LANE_WIDTH);
+            int max_x = (int)Clamp(cull_slots.max_x - (int)lane->origin.x, -1, LANE_WIDTH - 1);
+            for (int x = min_x; x <= max_x; x++) {
+                for (int y = cull_slots.min_y; y <= cull_slots.max_y; y++) {
+                    int c = x * SLOTS_Y + y;
+                    if (lod && crowded[lane->origin.x + x][y]) {
+                        continue;
+                    }
+                    for (int k = lane->cell_start[c]; k < lane->cell_start[c + 1]; k++) {
+                        if (lane->cell_items[k] == INDEX_NONE) {
+                            continue;
+                        }
+                        const Minion *minion = &lane->minions[lane->cell_items[k]];
+                        rectInstances[instance_count++] = (RectInstance) { minion->position.x, minion->position.y, minion->size.x, minion->kind };
+                    }
+                }
             }
-            Vector2 offset_pos = calc_position_centered_at_origin(get_slot_origin(towers[i].slot_pos), towers[i].size);
-            DrawRectangleV(offset_pos, towers[i].size, towers[i].color);
-            // We can break early if we already have found all of the towers and drawn them
-            if (--tower_count == 0) {
-                break;
+            // Minions handed over from the previous lane after the index was built
+            for (int i = lane->indexed_count; i < lane->minion_count; i++) {
+                const Minion *minion = &lane->minions[i];
+                if (CheckCollisionPointRec(minion->position, cull_rect)) {
+                    rectInstances[instance_count++] = (RectInstance) { minion->position.x, minion->position.y, minion->size.x, minion->kind };
+                }
             }
         }
-
-        // Iterate all paths
-        int path_count = currentPaths;
-        for (int i = 0; i < SLOTS_X; i++) {
-            for (int j = 0; j < SLOTS_Y; j++) {
-                if (!paths[i][j].alive) {
-                    continue;
+        for (int l = 0; l < LANE_COUNT; l++) {
+            const Lane *lane = &lanes[l];
+            if ((int)lane->origin.x + LANE_WIDTH <= cull_slots.min_x || (int)lane->origin.x > cull_slots.max_x) {
+                continue;
+            }
+            for (int i = 0; i < lane->bullet_count; i++) {
+                const Bullet *bullet = &lane->bullets[i];
+                if (CheckCollisionPointRec(bullet->position, cull_rect)) {
+                    rectInstances[instance_count++] = (RectInstance) { bullet->position.x, bullet->position.y, bullet->size.x, PROJECTILE_PALETTE_INDEX };
                 }
-                Vector2 origin = get_slot_origin((SlotVector2) { i, j });
-                Vector2 offset_pos = calc_position_centered_at_origin(origin, (Vector2) { SQUARE_SIZE, SQUARE_SIZE });
-                DrawRectangleV(offset_pos, (Vector2) { SQUARE_SIZE, SQUARE_SIZE }, paths[i][j].color);
-                // We can break early if we already have found all of the towers and drawn them
-                if (--path_count == 0) {
-                    break;
+            }
+        }
+        instance_count += PackParticles(&rectInstances[instance_count], MAX_RECT_INSTANCES - instance_count, cull_rect);
+        DrawRectInstances(rectInstances, instance_count);
+        DrawDamageNumbers(cull_rect, DAMAGE_NUMBER_COLOR);
+
+        // Ranges and the cursor are single quads shaded by distance, all of them in one draw call
+        BeginOverlays();
+        const Tower *hovered = get_tower_at_slot(world_pos_to_slot_space(cursor.position));
+        for (int l = 0; l < LANE_COUNT && showAllRanges; l++) {
+            const Lane *lane = &lanes[l];
+            for (int i = 0; i < lane->tower_count; i++) {
+                if (&lane->towers[i] != hovered) {
+                    draw_tower_range(get_slot_origin(lane->towers[i].slot_pos), get_tower_range(&lane->towers[i]), lane->towers[i].color, view);
                 }
             }
         }
+        if (hovered != NULL) {
+            draw_tower_range(get_slot_origin(hovered->slot_pos), get_tower_range(hovered), cursor.color, view);
+        } else {
+            draw_tower_range(Vector2Add(cursor.position, Vector2Scale(cursor.size, 0.5f)), tower_defs[selectedTower].range, tower_defs[selectedTower].color, view);
+        }
+        DrawOverlayRectangleRounded(pos_and_size_to_rect(cursor.position, cursor.size), CURSOR_CORNER_RADIUS, BORDER_THICKNESS, cursor.color);
+        EndOverlays();
 
-        // Draw cursor
-        // We draw this last after drawing the grid since renderer will already be in line mode
-        // Switching between line mode and normal draw mode triggers a flush
-        DrawRectangleLinesEx(pos_and_size_to_rect(cursor.position, cursor.size), BORDER_THICKNESS, cursor.color);
+        EndMode2D();
+    }
 
-        const char *gold_text = TextFormat("GOLD: %d", gold);
-        DrawText(gold_text, screenWidth - MeasureText(gold_text, 25) - 10, 10, 25, GRAY);
+    // Everything else goes through the draw list, which groups it by draw mode and texture inside each layer
+    BeginDrawList();
 
-        if (pause)
-            DrawText("GAME PAUSED", screenWidth / 2 - MeasureText("GAME PAUSED", 40) / 2, screenHeight / 2 - 40, 40, GRAY);
-#ifdef DEBUG
-        else {
-            DrawFPS(screenWidth - 90, screenHeight - 25);
+    if (!gameOver) {
+        if (hud_label_changed(&goldLabel, player_gold[LOCAL_PLAYER], player_income[LOCAL_PLAYER], 0)) {
+            UpdateTextLayoutDefault(&goldLabel.layout, TextFormat("GOLD: %d (+%d)", player_gold[LOCAL_PLAYER], player_income[LOCAL_PLAYER]), 25);
+        }
+        int gold_x = screenWidth - (int)goldLabel.layout.size.x - 10;
+        DrawListTextLayout(DRAW_LAYER_HUD, &goldLabel.layout, (Vector2) { gold_x, 10 }, GRAY);
+        DrawListTexture(DRAW_LAYER_HUD, spriteAtlas.texture, spriteAtlas.sprites[SPRITE_GOLD], (Rectangle) { gold_x - HUD_ICON_SIZE - 6, 12, HUD_ICON_SIZE, HUD_ICON_SIZE }, WHITE);
+
+        if (hud_label_changed(&livesLabel, lives[LOCAL_TEAM], 0, 0)) {
+            UpdateTextLayoutDefault(&livesLabel.layout, TextFormat("LIVES: %d", lives[LOCAL_TEAM]), 25);
+        }
+        DrawListTexture(DRAW_LAYER_HUD, spriteAtlas.texture, spriteAtlas.sprites[SPRITE_LIVES], (Rectangle) { 10, 12, HUD_ICON_SIZE, HUD_ICON_SIZE }, WHITE);
+        DrawListTextLayout(DRAW_LAYER_HUD, &livesLabel.layout, (Vector2) { 10 + HUD_ICON_SIZE + 6, 10 }, GRAY);
+
+        if (hud_label_changed(&towerLabel, selectedTower, 0, 0)) {
+            UpdateTextLayoutDefault(&towerLabel.layout, TextFormat("[%d] %s: %d", selectedTower + 1, tower_defs[selectedTower].name, tower_defs[selectedTower].cost), 20);
+        }
+        int tower_x = screenWidth - (int)towerLabel.layout.size.x - 10;
+        DrawListTextLayout(DRAW_LAYER_HUD, &towerLabel.layout, (Vector2) { tower_x, 40 }, tower_defs[selectedTower].color);
+        DrawListTexture(DRAW_LAYER_HUD, spriteAtlas.texture, spriteAtlas.sprites[SPRITE_TOWER + selectedTower], (Rectangle) { tower_x - HUD_ICON_SIZE - 6, 40, HUD_ICON_SIZE, HUD_ICON_SIZE }, WHITE);
+
+        const Tower *hovered = get_tower_at_slot(world_pos_to_slot_space(cursor.position));
+        if (hovered != NULL) {
+            int upgrade_cost = hovered->level < MAX_TOWER_LEVEL ? get_tower_upgrade_cost(hovered) : -1;
+            if (hud_label_changed(&hoveredLabel, hovered->level, upgrade_cost, get_tower_sell_refund(hovered))) {
+                const char *hovered_text = upgrade_cost >= 0
+                    ? TextFormat("LVL %d [U] %d [X] +%d", hovered->level + 1, upgrade_cost, get_tower_sell_refund(hovered))
+                    : TextFormat("LVL %d [X] +%d", hovered->level + 1, get_tower_sell_refund(hovered));
+                UpdateTextLayoutDefault(&hoveredLabel.layout, hovered_text, 20);
+            }
+            DrawListTextLayout(DRAW_LAYER_HUD, &hoveredLabel.layout, (Vector2) { screenWidth - (int)hoveredLabel.layout.size.x - 10, 65 }, GRAY);
         }
+
+        if (pause) {
+            UpdateTextLayoutDefault(&pausedLayout, "GAME PAUSED", 40);
+            DrawListTextLayout(DRAW_LAYER_HUD, &pausedLayout, (Vector2) { screenWidth / 2 - (int)pausedLayout.size.x / 2, screenHeight / 2 - 40 }, GRAY);
+        }
+    } else {
+        UpdateTextLayoutDefault(&gameOverLayout, "PRESS [ENTER] TO PLAY AGAIN", 20);
+        DrawListTextLayout(DRAW_LAYER_HUD, &gameOverLayout, (Vector2) { GetScreenWidth() / 2 - (int)gameOverLayout.size.x / 2, GetScreenHeight() / 2 - 50 }, GRAY);
+    }
+
+    EndDrawList();
+
+#ifdef DEBUG
+    if (!gameOver && !pause) {
+        DrawFPS(screenWidth - 90, screenHeight - 25);
+        DrawText(TextFormat("JITTER: %.2f ms", GetFrameTimeJitter() * 1000.0f), screenWidth - 110, screenHeight - 37, 10, DARKGRAY);
+        DrawListStats list_stats = GetDrawListStats();
+        DrawText(TextFormat("LIST: %d cmds %d draws (-%d)", list_stats.commands, list_stats.draw_calls, list_stats.draw_calls_saved), 10, screenHeight - 20, 10, DARKGRAY);
+        ParticleStats particle_stats = GetParticleStats();
+        DrawText(TextFormat("FX: %d alive %d throttled, %d numbers", particle_stats.alive, particle_stats.throttled, GetDamageNumberCount()), 10, screenHeight - 32, 10, DARKGRAY);
+        DrawText(TextFormat("GPU: %d draws %d verts, %d flushes (%d overflow), %d binds %d states, %d KB", lastRenderStats.drawCalls, lastRenderStats.vertices, lastRenderStats.flushes, lastRenderStats.overflowFlushes, lastRenderStats.textureBinds, lastRenderStats.stateChanges, lastRenderStats.bytesUploaded / 1024), 10, screenHeight - 44, 10, DARKGRAY);
+    }
 #endif
-    } else
-        DrawText("PRESS [ENTER] TO PLAY AGAIN", GetScreenWidth() / 2 - MeasureText("PRESS [ENTER] TO PLAY AGAIN", 20) / 2, GetScreenHeight() / 2 - 50, 20, GRAY);
+#ifdef PROFILER
+    if (showProfiler) {
+        DrawProfilerOverlay(10, 90);
+    }
+#endif
+    PROFILE_END(PROFILE_DRAW_LIST);
+
+    // Flushed here rather than in EndDrawing() so the swap is timed on its own
+    PROFILE_BEGIN(PROFILE_FLUSH);
+    rlDrawRenderBatchActive();
+    PROFILE_END(PROFILE_FLUSH);
 
+    PROFILE_BEGIN(PROFILE_SWAP);
     EndDrawing();
+    PROFILE_END(PROFILE_SWAP);
+
+#ifdef DEBUG
+    lastRenderStats = rlGetRenderStats();
+#endif
 }
 
 // Unload game variables
 void UnloadGame(void)
 {
-    // TODO: Unload all dynamic loaded data (textures, sounds, models...)
+    UnloadTilemap(boardTilemap);
+    UnloadTexture(crowdHeat);
+    SetShapesTexture(defaultShapesTexture, defaultShapesRec);
+    UnloadAtlas(spriteAtlas);
+    UnloadRenderTexture(boardLayer);
+    UnloadInstancing();
+    UnloadOverlays();
+#if defined(SIM_THREADS)
+    stop_sim_workers();
+#endif
 }
 
 // Update and Draw (one frame)
 void UpdateDrawFrame(void)
 {
+#ifdef PROFILER
+    BeginProfileFrame();
+#endif
     UpdateGame();
     DrawGame();
 }
@@ -0,0 +1,111 @@
+#include "textlayout.h"
+#include "rlgl.h"
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define DEFAULT_FONT_SIZE 10 // Height of the default font glyphs, see DrawText()
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions (local)
+//------------------------------------------------------------------------------------
+
+static inline bool is_same_layout(const TextLayout *layout, Font font, const char *text, float fontSize, float spacing)
+{
+    return layout->font.texture.id == font.texture.id && layout->font.glyphs == font.glyphs && layout->fontSize == fontSize
+        && layout->spacing == spacing && strncmp(layout->text, text, MAX_TEXT_LAYOUT_LENGTH - 1) == 0;
+}
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+bool UpdateTextLayout(TextLayout *layout, Font font, const char *text, float fontSize, float spacing)
+{
+    if (is_same_layout(layout, font, text, fontSize, spacing)) {
+        return false;
+    }
+
+    strncpy(layout->text, text, MAX_TEXT_LAYOUT_LENGTH - 1);
+    layout->text[MAX_TEXT_LAYOUT_LENGTH - 1] = '\0';
+    layout->font = font;
+    layout->fontSize = fontSize;
+    layout->spacing = spacing;
+    layout->quadCount = 0;
+    layout->size = (Vector2) { 0.0f, fontSize };
+
+    // Same placement as DrawTextEx() and DrawTextCodepoint(), done once instead of every frame
+    float scale = fontSize / font.baseSize;
+    float padding = font.glyphPadding;
+    Vector2 pen = { 0 };
+    for (int i = 0; layout->text[i] != '\0';) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(&layout->text[i], &bytes);
+        i += bytes;
+
+        if (codepoint == '\n') {
+            pen.x = 0.0f;
+            pen.y += fontSize + TEXT_LAYOUT_LINE_SPACING;
+            layout->size.y += fontSize + TEXT_LAYOUT_LINE_SPACING;
+            continue;
+        }
+
+        int index = GetGlyphIndex(font, codepoint);
+        const GlyphInfo *glyph = &font.glyphs[index];
+        Rectangle rec = font.recs[index];
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            layout->quads[layout->quadCount] = (Rectangle) {
+                pen.x + (glyph->offsetX - padding) * scale,
+                pen.y + (glyph->offsetY - padding) * scale,
+                (rec.width + 2.0f * padding) * scale,
+                (rec.height + 2.0f * padding) * scale,
+            };
+            layout->texcoords[layout->quadCount] = (Rectangle) {
+                (rec.x - padding) / font.texture.width,
+                (rec.y - padding) / font.texture.height,
+                (rec.width + 2.0f * padding) / font.texture.width,
+                (rec.height + 2.0f * padding) / font.texture.height,
+            };
+            layout->quadCount++;
+        }
+
+        pen.x += (glyph->advanceX == 0 ? rec.width : glyph->advanceX) * scale + spacing;
+        if (pen.x - spacing > layout->size.x) {
+            layout->size.x = pen.x - spacing;
+        }
+    }
+
+    return true;
+}
+
+bool UpdateTextLayoutDefault(TextLayout *layout, const char *text, int fontSize)
+{
+    if (fontSize < DEFAULT_FONT_SIZE) {
+        fontSize = DEFAULT_FONT_SIZE;
+    }
+    return UpdateTextLayout(layout, GetFontDefault(), text, fontSize, fontSize / DEFAULT_FONT_SIZE);
+}
+
+void DrawTextLayout(const TextLayout *layout, Vector2 position, Color tint)
+{
+    if (layout->quadCount == 0) {
+        return;
+    }
+
+    rlSetTexture(layout->font.texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    for (int i = 0; i < layout->quadCount; i++) {
+        Rectangle quad = layout->quads[i];
+        Rectangle texcoord = layout->texcoords[i];
+        rlRectangle2f(position.x + quad.x, position.y + quad.y, quad.width, quad.height,
+            texcoord.x, texcoord.y, texcoord.x + texcoord.width, texcoord.y + texcoord.height);
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+}
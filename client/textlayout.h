@@ -0,0 +1,35 @@
+#ifndef TEXTLAYOUT_H
+#define TEXTLAYOUT_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MAX_TEXT_LAYOUT_LENGTH 128 // Bytes of text, including the terminator
+#define TEXT_LAYOUT_LINE_SPACING 2 // Same as raylib's default SetTextLineSpacing()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// The glyph quads of a string, laid out once and drawn as they are for as long as the string doesn't change
+typedef struct TextLayout {
+    char text[MAX_TEXT_LAYOUT_LENGTH]; // Text the quads were laid out for
+    Font font;
+    float fontSize;
+    float spacing;
+    Vector2 size; // Of the whole text, like MeasureTextEx()
+    int quadCount;
+    Rectangle quads[MAX_TEXT_LAYOUT_LENGTH]; // Relative to the drawing position
+    Rectangle texcoords[MAX_TEXT_LAYOUT_LENGTH]; // Normalized, in the font texture
+} TextLayout;
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+bool UpdateTextLayout(TextLayout *layout, Font font, const char *text, float fontSize, float spacing); // Lay out text again if it or the font changed, returns true if it did
+bool UpdateTextLayoutDefault(TextLayout *layout, const char *text, int fontSize); // Same, with the default font and the size and spacing DrawText() uses
+void DrawTextLayout(const TextLayout *layout, Vector2 position, Color tint); // Draw the laid out quads, no glyph lookups
+
+#endif // TEXTLAYOUT_H
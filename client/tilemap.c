@@ -0,0 +1,157 @@
+#include "tilemap.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+
+static const char *tilemapVertexShader = "in vec3 vertexPosition;\n"
+                                         "in vec2 vertexTexCoord;\n"
+                                         "uniform mat4 mvp;\n"
+                                         "out vec2 fragTexCoord;\n"
+                                         "void main()\n"
+                                         "{\n"
+                                         "    fragTexCoord = vertexTexCoord;\n"
+                                         "    gl_Position = mvp * vec4(vertexPosition, 1.0);\n"
+                                         "}\n";
+
+// Grid lines are the first pixel row and column of every tile plus the closing edge of the map, FILL tiles cover them
+// NOTE: Works in cell space so only offsets inside a tile are in pixels, absolute pixels go past mediump range on large maps
+static const char *tilemapFragmentShader = "in vec2 fragTexCoord;\n"
+                                           "out vec4 finalColor;\n"
+                                           "uniform sampler2D texture0;\n"
+                                           "uniform vec2 mapSize;\n"
+                                           "uniform float tileSize;\n"
+                                           "uniform vec4 palette[16];\n"
+                                           "uniform vec4 gridColor;\n"
+                                           "uniform vec4 backgroundColor;\n"
+                                           "void main()\n"
+                                           "{\n"
+                                           "    vec2 position = fragTexCoord * mapSize;\n"
+                                           "    vec2 cell = min(floor(position), mapSize - 1.0);\n"
+                                           "    int tile = int(texelFetch(texture0, ivec2(cell), 0).r * 255.0 + 0.5);\n"
+                                           "    int shape = tile / 16;\n"
+                                           "    vec4 color = palette[tile - shape * 16];\n"
+                                           "    vec2 local = (position - cell) * tileSize;\n"
+                                           "    vec2 lastCell = step(mapSize - 1.0, cell);\n"
+                                           "    bool edge = any(lessThan(local, vec2(1.0))) || any(greaterThanEqual(local * lastCell, vec2(tileSize - 1.0)));\n"
+                                           "    finalColor = edge ? gridColor : backgroundColor;\n"
+                                           "    if (shape == 1) finalColor = color;\n"
+                                           "    if (shape == 2 && all(greaterThanEqual(local, vec2(tileSize * 0.25))) && all(lessThan(local, vec2(tileSize * 0.75)))) finalColor = color;\n"
+                                           "}\n";
+
+//------------------------------------------------------------------------------------
+// Module Functions Definitions
+//------------------------------------------------------------------------------------
+
+Tilemap LoadTilemap(int width, int height, float tileSize)
+{
+    Tilemap tilemap = { 0 };
+
+    // texelFetch() needs GLSL 330 or GLSL 300 es, highp because a texture coordinate has to resolve cells of maps up to 1024 tiles
+    int version = rlGetVersion();
+    if (version != RL_OPENGL_33 && version != RL_OPENGL_43 && version != RL_OPENGL_ES_30) {
+        TraceLog(LOG_INFO, "TILEMAP: Not supported by the graphics API");
+        return tilemap;
+    }
+
+    const char *header = version == RL_OPENGL_ES_30 ? "#version 300 es\nprecision highp float;\n" : "#version 330\n";
+    char *vs = malloc(strlen(header) + strlen(tilemapVertexShader) + 1);
+    char *fs = malloc(strlen(header) + strlen(tilemapFragmentShader) + 1);
+    strcat(strcpy(vs, header), tilemapVertexShader);
+    strcat(strcpy(fs, header), tilemapFragmentShader);
+    tilemap.shader = LoadShaderFromMemory(vs, fs);
+    free(vs);
+    free(fs);
+
+    if (tilemap.shader.id == rlGetShaderIdDefault()) {
+        TraceLog(LOG_WARNING, "TILEMAP: Failed to load shader");
+        tilemap.shader = (Shader) { 0 };
+        return tilemap;
+    }
+
+    Image image = {
+        .data = calloc(width * height, 1),
+        .width = width,
+        .height = height,
+        .mipmaps = 1,
+        .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE,
+    };
+    tilemap.tiles = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    tilemap.width = width;
+    tilemap.height = height;
+    tilemap.tileSize = tileSize;
+    tilemap.mapSizeLoc = GetShaderLocation(tilemap.shader, "mapSize");
+    tilemap.tileSizeLoc = GetShaderLocation(tilemap.shader, "tileSize");
+    tilemap.paletteLoc = GetShaderLocation(tilemap.shader, "palette");
+    tilemap.gridColorLoc = GetShaderLocation(tilemap.shader, "gridColor");
+    tilemap.backgroundColorLoc = GetShaderLocation(tilemap.shader, "backgroundColor");
+
+    Vector2 mapSize = { width, height };
+    SetShaderValue(tilemap.shader, tilemap.mapSizeLoc, &mapSize, SHADER_UNIFORM_VEC2);
+    SetShaderValue(tilemap.shader, tilemap.tileSizeLoc, &tileSize, SHADER_UNIFORM_FLOAT);
+
+    return tilemap;
+}
+
+bool IsTilemapReady(Tilemap tilemap)
+{
+    return tilemap.tiles.id > 0 && tilemap.shader.id > 0;
+}
+
+void UnloadTilemap(Tilemap tilemap)
+{
+    if (!IsTilemapReady(tilemap)) {
+        return;
+    }
+    UnloadTexture(tilemap.tiles);
+    UnloadShader(tilemap.shader);
+}
+
+void SetTilemapColors(Tilemap tilemap, const Color *palette, int count, Color grid, Color background)
+{
+    Vector4 normalized[MAX_TILEMAP_COLORS] = { 0 };
+    for (int i = 0; i < count && i < MAX_TILEMAP_COLORS; i++) {
+        normalized[i] = ColorNormalize(palette[i]);
+    }
+    Vector4 gridNormalized = ColorNormalize(grid);
+    Vector4 backgroundNormalized = ColorNormalize(background);
+
+    SetShaderValueV(tilemap.shader, tilemap.paletteLoc, normalized, SHADER_UNIFORM_VEC4, MAX_TILEMAP_COLORS);
+    SetShaderValue(tilemap.shader, tilemap.gridColorLoc, &gridNormalized, SHADER_UNIFORM_VEC4);
+    SetShaderValue(tilemap.shader, tilemap.backgroundColorLoc, &backgroundNormalized, SHADER_UNIFORM_VEC4);
+}
+
+void SetTilemapTile(Tilemap tilemap, int x, int y, unsigned char tile)
+{
+    UpdateTextureRec(tilemap.tiles, (Rectangle) { x, y, 1, 1 }, &tile);
+}
+
+void SetTilemapTiles(Tilemap tilemap, const unsigned char *tiles)
+{
+    UpdateTexture(tilemap.tiles, tiles);
+}
+
+void DrawTilemap(Tilemap tilemap, Vector2 position)
+{
+    DrawTilemapRegion(tilemap, (Rectangle) { 0, 0, tilemap.width, tilemap.height }, position);
+}
+
+void DrawTilemapRegion(Tilemap tilemap, Rectangle tiles, Vector2 position)
+{
+    // Texture coordinates stay normalized to the whole map, so the shader finds the same cells for any region
+    Rectangle dest = {
+        position.x + tiles.x * tilemap.tileSize,
+        position.y + tiles.y * tilemap.tileSize,
+        tiles.width * tilemap.tileSize,
+        tiles.height * tilemap.tileSize,
+    };
+
+    BeginShaderMode(tilemap.shader);
+    DrawTexturePro(tilemap.tiles, tiles, dest, (Vector2) { 0 }, 0.0f, WHITE);
+    EndShaderMode();
+}
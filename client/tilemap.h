@@ -0,0 +1,47 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MAX_TILEMAP_COLORS 16
+
+// A tile is a single byte: a shape in the high nibble and a palette index in the low nibble
+#define TILE_SHAPE_EMPTY 0 // Background and grid lines only
+#define TILE_SHAPE_FILL 1 // The whole tile, covering the grid lines
+#define TILE_SHAPE_FOOTPRINT 2 // A half-size square centered in the tile
+#define TILEMAP_TILE(shape, color) ((unsigned char)((shape) * 16 + (color)))
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// A grid of tiles drawn as a single quad, the fragment shader looks up every pixel's tile in a data texture
+typedef struct Tilemap {
+    Texture2D tiles; // One R8 texel per tile
+    Shader shader;
+    int width; // In tiles
+    int height;
+    float tileSize; // In pixels
+    int mapSizeLoc;
+    int tileSizeLoc;
+    int paletteLoc;
+    int gridColorLoc;
+    int backgroundColorLoc;
+} Tilemap;
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration
+//------------------------------------------------------------------------------------
+Tilemap LoadTilemap(int width, int height, float tileSize); // Load a tilemap with every tile empty, requires OpenGL 3.3+ or ES 3.0
+bool IsTilemapReady(Tilemap tilemap); // Check if the tilemap was loaded and can be drawn
+void UnloadTilemap(Tilemap tilemap); // Unload the tile texture and shader
+void SetTilemapColors(Tilemap tilemap, const Color *palette, int count, Color grid, Color background); // Set the colors tiles index into
+void SetTilemapTile(Tilemap tilemap, int x, int y, unsigned char tile); // Update a single tile, uploads only that texel
+void SetTilemapTiles(Tilemap tilemap, const unsigned char *tiles); // Update every tile, tiles are width*height bytes in row-major order
+void DrawTilemap(Tilemap tilemap, Vector2 position); // Draw the whole tilemap with its top left corner at position
+void DrawTilemapRegion(Tilemap tilemap, Rectangle tiles, Vector2 position); // Draw only a rectangle of tiles, of the tilemap whose top left corner is at position
+
+#endif // TILEMAP_H